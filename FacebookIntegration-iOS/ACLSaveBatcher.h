@@ -0,0 +1,85 @@
+//
+//  ACLSaveBatcher.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiACL, KiiACLEntry, KiiObject, KiiFile;
+
+/** Returns a fresh KiiACL handle for the object whose ACL is being saved. Called once per parallel save */
+typedef KiiACL* (^ACLProvider)(void);
+
+/** Saves many KiiACLEntry changes with as few sequential round trips as possible
+
+ KiiACL saveSynchronous:didSucceed:didFail: sends one request per entry, one after another. The batcher first lists the entries already on the server and drops changes that would not alter anything (granting an entry that exists, or revoking one that does not). The remaining entries are split across `concurrency` independent KiiACL handles for the same object and saved in parallel, with at most `concurrency` saves in flight. Per-entry results are merged back, and entries that were skipped are reported as succeeded.
+ */
+@interface ACLSaveBatcher : NSObject
+
+/** A stable key for an entry's subject and action, used to compare entries
+
+ @param entry The entry to describe
+ @return A string such as "kiicloud://users/abc|4"
+ */
++ (NSString*) keyForEntry:(KiiACLEntry*)entry;
+
+
+/** Save entries to the ACL of a KiiObject
+
+ This is a blocking method.
+ @param entries The KiiACLEntry objects to grant or revoke
+ @param object The object whose ACL is modified. Must exist on the server
+ @param concurrency The maximum number of parallel saves. 0 uses a default of 4
+ @param succeeded An NSArray of entries that were saved, or were already in effect
+ @param failed An NSArray of entries that failed to save
+ @param error An NSError object, set to nil, to test for errors. partialACLFailure if any entry failed
+ */
++ (void) saveEntries:(NSArray*)entries
+            toObject:(KiiObject*)object
+     withConcurrency:(NSUInteger)concurrency
+          didSucceed:(NSArray**)succeeded
+             didFail:(NSArray**)failed
+            andError:(NSError**)error;
+
+
+/** Save entries to the ACL of a KiiFile
+
+ This is a blocking method.
+ @param entries The KiiACLEntry objects to grant or revoke
+ @param file The file whose ACL is modified. Must exist on the server
+ @param concurrency The maximum number of parallel saves. 0 uses a default of 4
+ @param succeeded An NSArray of entries that were saved, or were already in effect
+ @param failed An NSArray of entries that failed to save
+ @param error An NSError object, set to nil, to test for errors. partialACLFailure if any entry failed
+ */
++ (void) saveEntries:(NSArray*)entries
+              toFile:(KiiFile*)file
+     withConcurrency:(NSUInteger)concurrency
+          didSucceed:(NSArray**)succeeded
+             didFail:(NSArray**)failed
+            andError:(NSError**)error;
+
+
+/** Save entries to any ACL
+
+ This is a blocking method.
+ @param entries The KiiACLEntry objects to grant or revoke
+ @param provider A block returning a new KiiACL handle for the target on every call
+ @param targetURI The objectURI of the object, file or bucket the ACL belongs to, whose PermissionCache entry is refreshed with the saved entries. nil invalidates every cached target
+ @param concurrency The maximum number of parallel saves. 0 uses a default of 4
+ @param succeeded An NSArray of entries that were saved, or were already in effect
+ @param failed An NSArray of entries that failed to save
+ @param error An NSError object, set to nil, to test for errors. partialACLFailure if any entry failed
+ */
++ (void) saveEntries:(NSArray*)entries
+     withACLProvider:(ACLProvider)provider
+           forTarget:(NSString*)targetURI
+         concurrency:(NSUInteger)concurrency
+          didSucceed:(NSArray**)succeeded
+             didFail:(NSArray**)failed
+            andError:(NSError**)error;
+
+@end
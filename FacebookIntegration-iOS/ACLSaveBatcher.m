@@ -0,0 +1,184 @@
+//
+//  ACLSaveBatcher.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "ACLSaveBatcher.h"
+
+#import <KiiSDK/Kii.h>
+
+#import "NSError+KiiErrorCode.h"
+#import "PermissionCache.h"
+
+#define ACL_SAVE_DEFAULT_CONCURRENCY 4
+
+@implementation ACLSaveBatcher
+
++ (NSString*) keyForEntry:(KiiACLEntry*)entry {
+
+    // users and groups are identified by URI, the two pseudo-users by class
+    id subject = entry.subject;
+    NSString *subjectKey = [subject respondsToSelector:@selector(objectURI)] ? [subject objectURI] : NSStringFromClass([subject class]);
+
+    return [NSString stringWithFormat:@"%@|%d", subjectKey, (int)entry.action];
+}
+
++ (void) saveEntries:(NSArray*)entries
+            toObject:(KiiObject*)object
+     withConcurrency:(NSUInteger)concurrency
+          didSucceed:(NSArray**)succeeded
+             didFail:(NSArray**)failed
+            andError:(NSError**)error {
+
+    NSString *uri = object.objectURI;
+
+    [ACLSaveBatcher saveEntries:entries
+                withACLProvider:^KiiACL *{ return [KiiObject objectWithURI:uri].objectACL; }
+                      forTarget:uri
+                    concurrency:concurrency
+                     didSucceed:succeeded
+                        didFail:failed
+                       andError:error];
+}
+
++ (void) saveEntries:(NSArray*)entries
+              toFile:(KiiFile*)file
+     withConcurrency:(NSUInteger)concurrency
+          didSucceed:(NSArray**)succeeded
+             didFail:(NSArray**)failed
+            andError:(NSError**)error {
+
+    NSString *uri = file.objectURI;
+
+    [ACLSaveBatcher saveEntries:entries
+                withACLProvider:^KiiACL *{ return [KiiFile fileWithURI:uri].fileACL; }
+                      forTarget:uri
+                    concurrency:concurrency
+                     didSucceed:succeeded
+                        didFail:failed
+                       andError:error];
+}
+
++ (void) saveEntries:(NSArray*)entries
+     withACLProvider:(ACLProvider)provider
+           forTarget:(NSString*)targetURI
+         concurrency:(NSUInteger)concurrency
+          didSucceed:(NSArray**)succeeded
+             didFail:(NSArray**)failed
+            andError:(NSError**)error {
+
+    NSMutableArray *allSucceeded = [NSMutableArray array];
+    NSMutableArray *allFailed = [NSMutableArray array];
+
+    // drop changes that are already in effect on the server. If the listing
+    // fails, everything is sent - the save reports its own errors
+    NSError *listError = nil;
+    NSArray *current = [provider() listACLEntriesSynchronous:&listError];
+
+    NSMutableArray *pending = [NSMutableArray arrayWithCapacity:entries.count];
+
+    if(listError == nil) {
+
+        NSMutableSet *granted = [NSMutableSet setWithCapacity:current.count];
+        for(KiiACLEntry *entry in current) {
+            [granted addObject:[ACLSaveBatcher keyForEntry:entry]];
+        }
+
+        for(KiiACLEntry *entry in entries) {
+            BOOL exists = [granted containsObject:[ACLSaveBatcher keyForEntry:entry]];
+            if(entry.grant == exists) {
+                [allSucceeded addObject:entry];
+            } else {
+                [pending addObject:entry];
+            }
+        }
+
+    } else {
+        [pending addObjectsFromArray:entries];
+    }
+
+    // split what is left across independent ACL handles, saved in parallel
+    NSUInteger slots = (concurrency > 0) ? concurrency : ACL_SAVE_DEFAULT_CONCURRENCY;
+    NSUInteger chunkCount = MIN(slots, pending.count);
+    NSUInteger chunkSize = (chunkCount > 0) ? (pending.count + chunkCount - 1) / chunkCount : 0;
+
+    // at most `slots` saves in flight, whatever the width of the global queue
+    dispatch_semaphore_t inFlight = dispatch_semaphore_create(slots);
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+    for(NSUInteger i = 0; i < chunkCount; i++) {
+
+        NSRange range = NSMakeRange(i * chunkSize, MIN(chunkSize, pending.count - i * chunkSize));
+        NSArray *chunk = [pending subarrayWithRange:range];
+
+        dispatch_semaphore_wait(inFlight, DISPATCH_TIME_FOREVER);
+
+        dispatch_group_async(group, queue, ^{
+
+            KiiACL *acl = provider();
+            for(KiiACLEntry *entry in chunk) {
+                [acl putACLEntry:entry];
+            }
+
+            NSError *saveError = nil;
+            NSArray *chunkSucceeded = nil;
+            NSArray *chunkFailed = nil;
+            [acl saveSynchronous:&saveError didSucceed:&chunkSucceeded didFail:&chunkFailed];
+
+            @synchronized(allSucceeded) {
+                if(chunkSucceeded != nil || chunkFailed != nil) {
+                    [allSucceeded addObjectsFromArray:chunkSucceeded];
+                    [allFailed addObjectsFromArray:chunkFailed];
+                } else if(saveError != nil) {
+                    [allFailed addObjectsFromArray:chunk];
+                } else {
+                    [allSucceeded addObjectsFromArray:chunk];
+                }
+            }
+
+            dispatch_semaphore_signal(inFlight);
+        });
+    }
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    // refresh the cached permissions from the listing plus what was saved,
+    // without another round trip. Without a listing they can only be dropped
+    if(targetURI != nil && listError == nil) {
+
+        NSMutableDictionary *saved = [NSMutableDictionary dictionaryWithCapacity:current.count];
+        for(KiiACLEntry *entry in current) {
+            [saved setObject:entry forKey:[ACLSaveBatcher keyForEntry:entry]];
+        }
+        for(KiiACLEntry *entry in allSucceeded) {
+            if(entry.grant) {
+                [saved setObject:entry forKey:[ACLSaveBatcher keyForEntry:entry]];
+            } else {
+                [saved removeObjectForKey:[ACLSaveBatcher keyForEntry:entry]];
+            }
+        }
+
+        [[PermissionCache sharedCache] storeEntries:[saved allValues] forTarget:targetURI];
+
+    } else if(targetURI != nil) {
+        [[PermissionCache sharedCache] invalidateTarget:targetURI];
+    } else {
+        [[PermissionCache sharedCache] invalidateAll];
+    }
+
+    if(succeeded != NULL) {
+        *succeeded = allSucceeded;
+    }
+    if(failed != NULL) {
+        *failed = allFailed;
+    }
+    if(error != NULL) {
+        *error = (allFailed.count > 0) ? [NSError kiiErrorWithCode:KiiErrorPartialACLFailure] : nil;
+    }
+}
+
+@end
@@ -10,6 +10,9 @@
 
 #import <KiiSDK/Kii.h>
 
+#import "LoginPrefetcher.h"
+#import "LoginTrace.h"
+#import "SessionStore.h"
 #import "ViewController.h"
 
 @implementation AppDelegate
@@ -17,7 +20,22 @@
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions
 {
 
+#ifdef KII_STANDIN_URL
+    // load-test builds define KII_STANDIN_URL, e.g. KII_STANDIN_URL='"http://10.0.1.2:8080/api"',
+    // to send the SDK and the login prefetcher to a local stand-in server
+    [Kii beginWithID:@"28cdf645" andKey:@"165c5ef22896b3f4bde346124e0548ec" andCustomURL:@(KII_STANDIN_URL)];
+    [LoginPrefetcher sharedPrefetcher].apiURL = @(KII_STANDIN_URL);
+#else
     [Kii beginWithID:@"28cdf645" andKey:@"165c5ef22896b3f4bde346124e0548ec"];
+#endif
+
+    [[LoginTrace sharedTrace] addSink:[[LoginTraceLogSink alloc] init]];
+    [[LoginPrefetcher sharedPrefetcher] addDefaultTasksWithBuckets:nil];
+
+    // the cached user is usable right away - the token is validated in the background
+    [[SessionStore sharedStore] restoreSessionWithCompletion:^(KiiUser *user, NSError *error) {
+        NSLog(@"Restored user: %@ withError: %@ timeToAuthenticated: %.3fs", user, error, [SessionStore sharedStore].timeToAuthenticated);
+    }];
 
     self.window = [[UIWindow alloc] initWithFrame:[[UIScreen mainScreen] bounds]];
     // Override point for customization after application launch.
@@ -28,15 +46,22 @@
 }
 
 #pragma mark Social Req's
+- (BOOL) handleSocialURL:(NSURL*)url {
+    LoginTrace *trace = [LoginTrace sharedTrace];
+    [trace endSpan:@"facebook"];
+    [trace beginSpan:@"exchange"];
+    return [KiiSocialConnect handleOpenURL:url];
+}
+
 // Pre iOS 4.2 support
 - (BOOL)application:(UIApplication *)application handleOpenURL:(NSURL *)url {
-    return [KiiSocialConnect handleOpenURL:url];
+    return [self handleSocialURL:url];
 }
 
 // For iOS 4.2+ support
 - (BOOL)application:(UIApplication *)application openURL:(NSURL *)url
   sourceApplication:(NSString *)sourceApplication annotation:(id)annotation {
-    return [KiiSocialConnect handleOpenURL:url];
+    return [self handleSocialURL:url];
 }
 
 @end
@@ -0,0 +1,29 @@
+//
+//  Benchmarks.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+#ifdef DEBUG
+
+@class KiiUser;
+
+/** Before/after timings for the SDK wrappers, in debug builds only
+
+ Run by launching with the argument -RunBenchmarks YES. Each benchmark times the plain SDK call it replaces against the wrapper and logs both with NSLog, so numbers are taken on a real device against the real (or stand-in) server.
+ */
+@interface Benchmarks : NSObject
+
+/** Run every benchmark on a background queue
+
+ @param user The logged-in user, whose bucket holds any objects the benchmarks create
+ */
++ (void) runWithUser:(KiiUser*)user;
+
+@end
+
+#endif
@@ -0,0 +1,417 @@
+//
+//  Benchmarks.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "Benchmarks.h"
+
+#ifdef DEBUG
+
+#import <KiiSDK/Kii.h>
+
+#import "ACLSaveBatcher.h"
+#import "HedgedRead.h"
+#import "HMACContext.h"
+#import "SessionStore.h"
+#import "URLEncoding.h"
+
+// network benchmarks repeat each side this many times
+#define BENCHMARK_ROUNDS 3
+
+// CPU benchmarks run each side this many times
+#define BENCHMARK_ITERATIONS 20000
+
+@implementation Benchmarks
+
++ (NSTimeInterval) time:(void (^)(void))block {
+    NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+    block();
+    return [NSDate timeIntervalSinceReferenceDate] - start;
+}
+
++ (void) logName:(NSString*)name before:(NSTimeInterval)before after:(NSTimeInterval)after unit:(NSString*)unit {
+    NSLog(@"[benchmark] %-24s before: %10.4f%@  after: %10.4f%@  speedup: %.2fx",
+          [name UTF8String], before, unit, after, unit, (after > 0) ? before / after : 0);
+}
+
+#pragma mark - ACL saves
+
+// the entry counts the ACL benchmark is run at
+#define BENCHMARK_ACL_SIZES @[ @1, @10, @100 ]
+
+// two actions per subject, so 100 entries need 50 subjects
+#define BENCHMARK_ACL_GROUPS 48
+
+// Entries for the first `count` subject and action pairs. The owner is left
+// out, as a new object already grants it everything and the batcher would
+// skip those entries.
++ (NSArray*) aclEntries:(NSUInteger)count forSubjects:(NSArray*)subjects grant:(BOOL)grant {
+
+    NSMutableArray *entries = [NSMutableArray array];
+
+    for(id subject in subjects) {
+        for(NSNumber *action in @[ @(KiiACLObjectActionRead), @(KiiACLObjectActionWrite) ]) {
+            if(entries.count == count) {
+                return entries;
+            }
+            KiiACLEntry *entry = [KiiACLEntry entryWithSubject:subject andAction:[action intValue]];
+            entry.grant = grant;
+            [entries addObject:entry];
+        }
+    }
+
+    return entries;
+}
+
++ (NSTimeInterval) timeSequentialSave:(NSArray*)entries toObject:(KiiObject*)object {
+    return [Benchmarks time:^{
+        KiiACL *acl = object.objectACL;
+        for(KiiACLEntry *entry in entries) {
+            [acl putACLEntry:entry];
+        }
+        NSArray *succeeded = nil, *failed = nil;
+        NSError *saveError = nil;
+        [acl saveSynchronous:&saveError didSucceed:&succeeded didFail:&failed];
+    }];
+}
+
++ (NSTimeInterval) timeBatchedSave:(NSArray*)entries toObject:(KiiObject*)object {
+    return [Benchmarks time:^{
+        NSError *saveError = nil;
+        [ACLSaveBatcher saveEntries:entries
+                           toObject:object
+                    withConcurrency:0
+                         didSucceed:nil
+                            didFail:nil
+                           andError:&saveError];
+    }];
+}
+
+// KiiACL saveSynchronous: one entry after another, against ACLSaveBatcher, at
+// 1, 10 and 100 entries. Each side saves to its own new object, so both start
+// from the same default ACL, and the side that runs first alternates. A grant
+// and then a revoke of the same entries are timed on each object.
++ (void) runACLSaveForUser:(KiiUser*)user {
+
+    NSMutableArray *groups = [NSMutableArray array];
+    NSMutableArray *subjects = [NSMutableArray arrayWithObjects:[KiiAnyAuthenticatedUser aclSubject], [KiiAnonymousUser aclSubject], nil];
+
+    for(int i = 0; i < BENCHMARK_ACL_GROUPS; i++) {
+        KiiGroup *group = [KiiGroup groupWithName:[NSString stringWithFormat:@"benchmark%d", i]];
+        NSError *error = nil;
+        [group saveSynchronous:&error];
+        if(error != nil) {
+            NSLog(@"[benchmark] ACL save skipped: %@", error);
+            for(KiiGroup *created in groups) {
+                [created deleteSynchronous:nil];
+            }
+            return;
+        }
+        [groups addObject:group];
+        [subjects addObject:group];
+    }
+
+    KiiBucket *bucket = [user bucketWithName:@"benchmarks"];
+
+    for(NSNumber *size in BENCHMARK_ACL_SIZES) {
+
+        NSTimeInterval sequential = 0;
+        NSTimeInterval batched = 0;
+        int measured = 0;
+
+        for(int round = 0; round < BENCHMARK_ROUNDS; round++) {
+
+            KiiObject *sequentialObject = [bucket createObject];
+            KiiObject *batchedObject = [bucket createObject];
+            NSError *error = nil;
+            [sequentialObject saveSynchronous:&error];
+            if(error == nil) {
+                [batchedObject saveSynchronous:&error];
+            }
+            if(error != nil) {
+                NSLog(@"[benchmark] ACL save round skipped: %@", error);
+                [sequentialObject deleteSynchronous:nil];
+                continue;
+            }
+
+            for(NSNumber *grant in @[ @TRUE, @FALSE ]) {
+
+                // fresh entries for each side, as saving changes their state
+                NSArray *sequentialEntries = [Benchmarks aclEntries:[size unsignedIntegerValue] forSubjects:subjects grant:[grant boolValue]];
+                NSArray *batchedEntries = [Benchmarks aclEntries:[size unsignedIntegerValue] forSubjects:subjects grant:[grant boolValue]];
+
+                if(round % 2 == 0) {
+                    sequential += [Benchmarks timeSequentialSave:sequentialEntries toObject:sequentialObject];
+                    batched += [Benchmarks timeBatchedSave:batchedEntries toObject:batchedObject];
+                } else {
+                    batched += [Benchmarks timeBatchedSave:batchedEntries toObject:batchedObject];
+                    sequential += [Benchmarks timeSequentialSave:sequentialEntries toObject:sequentialObject];
+                }
+                measured++;
+            }
+
+            [sequentialObject deleteSynchronous:nil];
+            [batchedObject deleteSynchronous:nil];
+        }
+
+        if(measured > 0) {
+            [Benchmarks logName:[NSString stringWithFormat:@"ACL save (%@ entries)", size] before:sequential / measured after:batched / measured unit:@"s"];
+        }
+    }
+
+    for(KiiGroup *group in groups) {
+        [group deleteSynchronous:nil];
+    }
+}
+
+#pragma mark - HMAC
+
+// KiiUtilities hmacsha1:key: rebuilds the key schedule for every message;
+// HMACContext prepares it once.
++ (void) runHMAC {
+
+    NSString *secret = @"165c5ef22896b3f4bde346124e0548ec";
+    NSString *message = @"GET\n/api/apps/28cdf645/users/me\n1792281600000\nx-kii-appid=28cdf645";
+
+    NSTimeInterval before = [Benchmarks time:^{
+        for(int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            @autoreleasepool {
+                [KiiUtilities hmacsha1:message key:secret];
+            }
+        }
+    }];
+
+    HMACContext *context = [HMACContext contextWithKeyString:secret andAlgorithm:HMACAlgorithmSHA1];
+    NSTimeInterval after = [Benchmarks time:^{
+        for(int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            @autoreleasepool {
+                [context hexSignatureForString:message];
+            }
+        }
+    }];
+
+    [Benchmarks logName:@"HMAC-SHA1 per message" before:before * 1e6 / BENCHMARK_ITERATIONS after:after * 1e6 / BENCHMARK_ITERATIONS unit:@"us"];
+}
+
+#pragma mark - URL encoding
+
+// KiiUtilities urlEncode:usingEncoding: against URLEncoding, over a mix of
+// keys that need no escaping and values that do.
++ (void) runURLEncoding {
+
+    NSArray *strings = @[ @"28cdf645", @"displayName", @"_created", @"1792281600000",
+                          @"Chris Beauchamp", @"a+b=c&d", @"caf\u00e9 \u6771\u4eac", @"kiicloud://users/4f9a0b2c" ];
+
+    NSUInteger bytes = 0;
+    for(NSString *string in strings) {
+        bytes += [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    }
+
+    NSTimeInterval before = [Benchmarks time:^{
+        for(int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            @autoreleasepool {
+                for(NSString *string in strings) {
+                    [KiiUtilities urlEncode:string usingEncoding:NSUTF8StringEncoding];
+                }
+            }
+        }
+    }];
+
+    NSTimeInterval after = [Benchmarks time:^{
+        for(int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            @autoreleasepool {
+                for(NSString *string in strings) {
+                    [URLEncoding encodeString:string];
+                }
+            }
+        }
+    }];
+
+    // reported as time per MB, so the speedup reads the same way as the others
+    double megabytes = (double)bytes * BENCHMARK_ITERATIONS / 1e6;
+    [Benchmarks logName:@"URL encode per MB" before:before / megabytes after:after / megabytes unit:@"s"];
+}
+
+#pragma mark - session restore
+
+// A cold start, timed to the user being shown and to the first authenticated
+// request: authenticating the token before anything renders, against the
+// keychain snapshot from SessionStore, which is validated in the background.
+// Either way [KiiUser currentUser] is only set once the token round trip is
+// done, so the first request is a refresh made after that.
++ (void) runSessionRestoreForUser:(KiiUser*)user {
+
+    NSString *token = user.accessToken;
+    if(token == nil) {
+        NSLog(@"[benchmark] session restore skipped: no access token");
+        return;
+    }
+
+    [[SessionStore sharedStore] saveSessionForUser:user];
+
+    NSTimeInterval authenticateShown = 0, authenticateRequest = 0;
+    NSTimeInterval restoreShown = 0, restoreRequest = 0;
+    int authenticateRounds = 0, restoreRounds = 0;
+    int authenticateFailures = 0, restoreFailures = 0;
+
+    for(int round = 0; round < BENCHMARK_ROUNDS; round++) {
+
+        NSTimeInterval started = [NSDate timeIntervalSinceReferenceDate];
+        NSError *error = nil;
+        KiiUser *authenticated = [KiiUser authenticateWithTokenSynchronous:token andError:&error];
+        NSTimeInterval shown = [NSDate timeIntervalSinceReferenceDate] - started;
+        if(error == nil) {
+            [authenticated refreshSynchronous:&error];
+        }
+        if(error == nil) {
+            authenticateShown += shown;
+            authenticateRequest += [NSDate timeIntervalSinceReferenceDate] - started;
+            authenticateRounds++;
+        } else {
+            authenticateFailures++;
+        }
+
+        // the completion runs on the main queue, which stays free while this waits
+        dispatch_semaphore_t done = dispatch_semaphore_create(0);
+        __block KiiUser *restored = nil;
+        __block NSError *restoreError = nil;
+
+        started = [NSDate timeIntervalSinceReferenceDate];
+        BOOL found = [[SessionStore sharedStore] restoreSessionWithCompletion:^(KiiUser *validatedUser, NSError *validationError) {
+            restored = validatedUser;
+            restoreError = validationError;
+            dispatch_semaphore_signal(done);
+        }];
+        shown = [NSDate timeIntervalSinceReferenceDate] - started;
+
+        if(!found) {
+            restoreFailures++;
+            continue;
+        }
+
+        dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+        error = restoreError;
+        if(error == nil && restored != nil) {
+            [[KiiUser currentUser] refreshSynchronous:&error];
+        }
+        if(error == nil && restored != nil) {
+            restoreShown += shown;
+            restoreRequest += [NSDate timeIntervalSinceReferenceDate] - started;
+            restoreRounds++;
+        } else {
+            restoreFailures++;
+        }
+    }
+
+    if(authenticateRounds > 0 && restoreRounds > 0) {
+        [Benchmarks logName:@"session: user shown" before:authenticateShown / authenticateRounds after:restoreShown / restoreRounds unit:@"s"];
+        [Benchmarks logName:@"session: first request" before:authenticateRequest / authenticateRounds after:restoreRequest / restoreRounds unit:@"s"];
+    }
+    NSLog(@"[benchmark] session: failed rounds - authenticate %d, restore %d of %d", authenticateFailures, restoreFailures, BENCHMARK_ROUNDS);
+}
+
+#pragma mark - hedged reads
+
+// objects refreshed by the hedged read benchmark, and reads per side
+#define BENCHMARK_HEDGED_OBJECTS 10
+#define BENCHMARK_HEDGED_READS 200
+
++ (NSTimeInterval) latencyAtPercentile:(double)percentile of:(NSArray*)sorted {
+    NSUInteger index = MIN((NSUInteger)(percentile * sorted.count), sorted.count - 1);
+    return [[sorted objectAtIndex:index] doubleValue];
+}
+
+// Refreshes the same objects through HedgedRead with hedging off, then on,
+// and compares the p50 and p95 of each side. The unhedged side runs first,
+// so the hedged side starts with the latency samples it needs.
++ (void) runHedgedReadForUser:(KiiUser*)user {
+
+    KiiBucket *bucket = [user bucketWithName:@"benchmarks"];
+    NSMutableArray *objects = [NSMutableArray array];
+
+    for(int i = 0; i < BENCHMARK_HEDGED_OBJECTS; i++) {
+        KiiObject *object = [bucket createObject];
+        NSError *error = nil;
+        [object saveSynchronous:&error];
+        if(error != nil) {
+            NSLog(@"[benchmark] hedged read skipped: %@", error);
+            for(KiiObject *created in objects) {
+                [created deleteSynchronous:nil];
+            }
+            return;
+        }
+        [objects addObject:object];
+    }
+
+    HedgedRead *hedger = [HedgedRead sharedHedger];
+    BOOL wasEnabled = hedger.enabled;
+    NSMutableArray *latencies[2] = { [NSMutableArray array], [NSMutableArray array] };
+    int failures[2] = { 0, 0 };
+    NSDictionary *statsBefore = nil;
+
+    for(int side = 0; side < 2; side++) {
+
+        // the counters are process-wide, so only the hedged side's share is reported
+        if(side == 1) {
+            statsBefore = [hedger statsForType:@"object.refresh"];
+        }
+        hedger.enabled = (side == 1);
+
+        for(int i = 0; i < BENCHMARK_HEDGED_READS; i++) {
+            KiiObject *object = [objects objectAtIndex:i % objects.count];
+            NSError *error = nil;
+            NSTimeInterval started = [NSDate timeIntervalSinceReferenceDate];
+            [hedger refreshObjectWithURI:object.objectURI andError:&error];
+            if(error == nil) {
+                [latencies[side] addObject:@([NSDate timeIntervalSinceReferenceDate] - started)];
+            } else {
+                failures[side]++;
+            }
+        }
+
+        [latencies[side] sortUsingSelector:@selector(compare:)];
+    }
+
+    hedger.enabled = wasEnabled;
+
+    if(latencies[0].count > 0 && latencies[1].count > 0) {
+        [Benchmarks logName:@"hedged read p50"
+                     before:[Benchmarks latencyAtPercentile:0.5 of:latencies[0]]
+                      after:[Benchmarks latencyAtPercentile:0.5 of:latencies[1]]
+                       unit:@"s"];
+        [Benchmarks logName:@"hedged read p95"
+                     before:[Benchmarks latencyAtPercentile:0.95 of:latencies[0]]
+                      after:[Benchmarks latencyAtPercentile:0.95 of:latencies[1]]
+                       unit:@"s"];
+    }
+
+    NSDictionary *stats = [hedger statsForType:@"object.refresh"];
+    NSLog(@"[benchmark] hedged read: %d hedges, %d won, %d denied; failed reads - off %d, on %d of %d",
+          [[stats objectForKey:@"hedges"] intValue] - [[statsBefore objectForKey:@"hedges"] intValue],
+          [[stats objectForKey:@"hedgeWins"] intValue] - [[statsBefore objectForKey:@"hedgeWins"] intValue],
+          [[stats objectForKey:@"hedgesDenied"] intValue] - [[statsBefore objectForKey:@"hedgesDenied"] intValue],
+          failures[0], failures[1], BENCHMARK_HEDGED_READS);
+
+    for(KiiObject *object in objects) {
+        [object deleteSynchronous:nil];
+    }
+}
+
+#pragma mark - running
+
++ (void) runWithUser:(KiiUser*)user {
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [Benchmarks runHMAC];
+        [Benchmarks runURLEncoding];
+        [Benchmarks runACLSaveForUser:user];
+        [Benchmarks runSessionRestoreForUser:user];
+        [Benchmarks runHedgedReadForUser:user];
+    });
+}
+
+@end
+
+#endif
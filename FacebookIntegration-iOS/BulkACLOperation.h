@@ -0,0 +1,71 @@
+//
+//  BulkACLOperation.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiBucket, KiiFileBucket, KiiQuery, KiiClause;
+
+/** Called on the main thread after each target is processed. total is 0 when the number of targets is not known up front, as with queries */
+typedef void (^BulkACLProgress)(NSUInteger processed, NSUInteger total);
+
+/** Called on the main thread for each target with at least one failed entry. failedEntries are copies made for that target, with the same subject, action and grant as the entries passed in. target is nil if the query or page listing the targets failed */
+typedef void (^BulkACLItemFailure)(id target, NSArray *failedEntries, NSError *error);
+
+/** Called on the main thread once every target has been processed, or the operation was cancelled */
+typedef void (^BulkACLCompletion)(NSUInteger succeeded, NSUInteger failed, BOOL cancelled);
+
+/** Applies one set of KiiACLEntry changes to many KiiObjects or KiiFiles
+
+ Targets come from an array, a KiiQuery on an object bucket, or a clause on a file bucket. Query results are paged in while earlier pages are being processed. Up to `concurrency` targets are saved at a time through ACLSaveBatcher, so entries already in effect on a target cost nothing beyond the ACL listing.
+ */
+@interface BulkACLOperation : NSObject
+
+/** The maximum number of targets processed at once. Defaults to 4 */
+@property (nonatomic, assign) NSUInteger concurrency;
+
+@property (nonatomic, copy) BulkACLProgress progressBlock;
+@property (nonatomic, copy) BulkACLItemFailure failureBlock;
+@property (nonatomic, copy) BulkACLCompletion completionBlock;
+
+/** Create an operation over an explicit list of targets
+
+ @param targets An array of KiiObject and/or KiiFile objects that exist on the server
+ @param entries The KiiACLEntry objects to grant or revoke on every target
+ @return A new BulkACLOperation, not yet started
+ */
++ (BulkACLOperation*) operationWithTargets:(NSArray*)targets andEntries:(NSArray*)entries;
+
+
+/** Create an operation over the objects returned by a query
+
+ @param query The query selecting the objects
+ @param bucket The bucket to run the query against
+ @param entries The KiiACLEntry objects to grant or revoke on every object
+ @return A new BulkACLOperation, not yet started
+ */
++ (BulkACLOperation*) operationWithQuery:(KiiQuery*)query onBucket:(KiiBucket*)bucket andEntries:(NSArray*)entries;
+
+
+/** Create an operation over the files matching a clause
+
+ @param clause The clause selecting the files. nil for all files
+ @param bucket The file bucket to page through
+ @param entries The KiiACLEntry objects to grant or revoke on every file
+ @return A new BulkACLOperation, not yet started
+ */
++ (BulkACLOperation*) operationWithClause:(KiiClause*)clause onFileBucket:(KiiFileBucket*)bucket andEntries:(NSArray*)entries;
+
+
+/** Start processing in the background. This is a non-blocking method */
+- (void) start;
+
+
+/** Stop starting new targets. Targets already in flight are allowed to finish */
+- (void) cancel;
+
+@end
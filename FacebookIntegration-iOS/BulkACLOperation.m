@@ -0,0 +1,213 @@
+//
+//  BulkACLOperation.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "BulkACLOperation.h"
+
+#import <KiiSDK/Kii.h>
+
+#import "ACLSaveBatcher.h"
+#import "FileBucketPager.h"
+
+#define BULK_ACL_DEFAULT_CONCURRENCY 4
+
+/** Returns the next batch of targets, an empty array when done, or nil and an error */
+typedef NSArray* (^BulkACLTargetSource)(NSError **error);
+
+@interface BulkACLOperation ()
+
+@property (nonatomic, strong) NSArray *entries;
+@property (nonatomic, copy) BulkACLTargetSource source;
+@property (nonatomic, assign) NSUInteger knownTotal;
+
+@property (assign) BOOL cancelled;
+@property (nonatomic, assign) NSUInteger processed;
+@property (nonatomic, assign) NSUInteger succeeded;
+@property (nonatomic, assign) NSUInteger failed;
+
+@end
+
+@implementation BulkACLOperation
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _concurrency = BULK_ACL_DEFAULT_CONCURRENCY;
+    }
+    return self;
+}
+
++ (BulkACLOperation*) operationWithTargets:(NSArray*)targets andEntries:(NSArray*)entries {
+
+    BulkACLOperation *operation = [[BulkACLOperation alloc] init];
+    operation.entries = [entries copy];
+    operation.knownTotal = targets.count;
+
+    __block NSArray *remaining = [targets copy];
+    operation.source = ^NSArray *(NSError **error) {
+        NSArray *batch = remaining;
+        remaining = [NSArray array];
+        return batch;
+    };
+
+    return operation;
+}
+
++ (BulkACLOperation*) operationWithQuery:(KiiQuery*)query onBucket:(KiiBucket*)bucket andEntries:(NSArray*)entries {
+
+    BulkACLOperation *operation = [[BulkACLOperation alloc] init];
+    operation.entries = [entries copy];
+
+    __block KiiQuery *nextQuery = query;
+    operation.source = ^NSArray *(NSError **error) {
+
+        if(nextQuery == nil) {
+            return [NSArray array];
+        }
+
+        KiiQuery *following = nil;
+        NSArray *results = [bucket executeQuerySynchronous:nextQuery withError:error andNext:&following];
+        nextQuery = following;
+
+        return results;
+    };
+
+    return operation;
+}
+
++ (BulkACLOperation*) operationWithClause:(KiiClause*)clause onFileBucket:(KiiFileBucket*)bucket andEntries:(NSArray*)entries {
+
+    BulkACLOperation *operation = [[BulkACLOperation alloc] init];
+    operation.entries = [entries copy];
+
+    FileBucketPager *pager = [FileBucketPager pagerWithBucket:bucket andClause:clause];
+    operation.source = ^NSArray *(NSError **error) {
+        return pager.hasMore ? [pager nextPageSynchronous:error] : [NSArray array];
+    };
+
+    return operation;
+}
+
+#pragma mark - running
+
+- (void) cancel {
+    self.cancelled = TRUE;
+}
+
+// The SDK changes an entry's state when it saves it, so targets saved in
+// parallel each get their own copy of the entries
+- (NSArray*) entriesForTarget {
+
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:_entries.count];
+
+    for(KiiACLEntry *entry in _entries) {
+        KiiACLEntry *copy = [KiiACLEntry entryWithSubject:entry.subject andAction:entry.action];
+        copy.grant = entry.grant;
+        [entries addObject:copy];
+    }
+
+    return entries;
+}
+
+- (void) saveTarget:(id)target {
+
+    NSArray *entries = [self entriesForTarget];
+    NSArray *failedEntries = nil;
+    NSError *error = nil;
+
+    // targets already run in parallel, so each one saves its entries serially
+    if([target isKindOfClass:[KiiFile class]]) {
+        [ACLSaveBatcher saveEntries:entries toFile:target withConcurrency:1 didSucceed:nil didFail:&failedEntries andError:&error];
+    } else {
+        [ACLSaveBatcher saveEntries:entries toObject:target withConcurrency:1 didSucceed:nil didFail:&failedEntries andError:&error];
+    }
+
+    NSUInteger processed, total;
+    @synchronized(self) {
+        if(error == nil) {
+            _succeeded++;
+        } else {
+            _failed++;
+        }
+        processed = ++_processed;
+        total = _knownTotal;
+    }
+
+    BulkACLProgress progressBlock = _progressBlock;
+    BulkACLItemFailure failureBlock = _failureBlock;
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if(error != nil && failureBlock != nil) {
+            failureBlock(target, failedEntries, error);
+        }
+        if(progressBlock != nil) {
+            progressBlock(processed, total);
+        }
+    });
+}
+
+- (void) start {
+
+    NSUInteger slotCount = (_concurrency > 0) ? _concurrency : BULK_ACL_DEFAULT_CONCURRENCY;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        dispatch_semaphore_t slots = dispatch_semaphore_create(slotCount);
+        dispatch_group_t group = dispatch_group_create();
+        dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+        while(!self.cancelled) {
+
+            NSError *error = nil;
+            NSArray *batch = self.source(&error);
+
+            if(error != nil) {
+                // the remaining targets are unreachable - report it as one failure
+                BulkACLItemFailure failureBlock = self.failureBlock;
+                if(failureBlock != nil) {
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        failureBlock(nil, nil, error);
+                    });
+                }
+                break;
+            }
+
+            if(batch.count == 0) {
+                break;
+            }
+
+            for(id target in batch) {
+
+                dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+                if(self.cancelled) {
+                    dispatch_semaphore_signal(slots);
+                    break;
+                }
+
+                dispatch_group_async(group, queue, ^{
+                    [self saveTarget:target];
+                    dispatch_semaphore_signal(slots);
+                });
+            }
+        }
+
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+        BulkACLCompletion completionBlock = self.completionBlock;
+        NSUInteger succeeded = self.succeeded;
+        NSUInteger failed = self.failed;
+        BOOL cancelled = self.cancelled;
+
+        if(completionBlock != nil) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completionBlock(succeeded, failed, cancelled);
+            });
+        }
+    });
+}
+
+@end
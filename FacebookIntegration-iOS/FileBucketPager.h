@@ -0,0 +1,84 @@
+//
+//  FileBucketPager.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiFileBucket, KiiClause;
+
+typedef enum {
+    FileTrashedFilterAny,
+    FileTrashedFilterActiveOnly,
+    FileTrashedFilterTrashedOnly
+} FileTrashedFilter;
+
+typedef void (^FilePageCompletion)(NSArray *files, NSError *error);
+
+/** Cursor-based pagination over the files in a KiiFileBucket
+
+ KiiFileBucket executeQuerySynchronous:withError: has no next-query parameter, so large buckets come back in a single response. The pager instead sorts on sortField and walks the bucket in pages of pageSize, using the sort value of the last file seen as the cursor for the next query. While one page is being consumed the next is fetched in the background.
+
+ Files created while paging are picked up if they sort after the cursor.
+ */
+@interface FileBucketPager : NSObject
+
+/** The number of files requested per page. Defaults to 100 */
+@property (nonatomic, assign) int pageSize;
+
+/** The field to sort and page on, either _created or _modified - other values are rejected. Must be set before the first page. Defaults to _created */
+@property (nonatomic, strong) NSString *sortField;
+
+/** The server field holding the trashed flag, used when trashedFilter is set. Defaults to _trashed, which the SDK does not document, so check it against the server before relying on trashedFilter */
+@property (nonatomic, strong) NSString *trashedField;
+
+/** Filters on the trashed flag server-side. Opt-in: a wrong trashedField matches no files without an error. Must be set before the first page. Defaults to FileTrashedFilterAny */
+@property (nonatomic, assign) FileTrashedFilter trashedFilter;
+
+/** Whether the following page is fetched in the background as soon as a page is returned. Defaults to TRUE */
+@property (nonatomic, assign) BOOL prefetch;
+
+/** FALSE once the last page has been returned */
+@property (readonly) BOOL hasMore;
+
+/** Create a pager over a file bucket
+
+ @param bucket The bucket to page through
+ @param clause An optional clause to filter files by. Pass nil for all files
+ @return A new FileBucketPager positioned before the first page
+ */
++ (FileBucketPager*) pagerWithBucket:(KiiFileBucket*)bucket andClause:(KiiClause*)clause;
+
+
+/** Get the next page of files
+
+ This is a blocking method
+ @param error An NSError object, set to nil, to test for errors
+ @return An array of KiiFile objects. Empty once there are no more files
+ */
+- (NSArray*) nextPageSynchronous:(NSError**)error;
+
+
+/** Get the next page of files
+
+ This is a non-blocking method
+ @param completion The block called on the main thread with the page of files, or an error
+ */
+- (void) nextPage:(FilePageCompletion)completion;
+
+
+/** A streaming enumerator over every remaining file
+
+ Pages are fetched as the enumerator is advanced, so nextObject may block on the network - use it from a background thread. Enumeration ends early if a page fails to load.
+ @return An NSEnumerator of KiiFile objects
+ */
+- (NSEnumerator*) fileEnumerator;
+
+
+/** Discard the cursor and any prefetched page, and start again from the first page */
+- (void) reset;
+
+@end
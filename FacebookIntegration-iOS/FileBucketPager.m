@@ -0,0 +1,293 @@
+//
+//  FileBucketPager.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "FileBucketPager.h"
+
+#import <KiiSDK/Kii.h>
+
+// KiiQuery limit must be in (0, 100]
+#define KII_MAX_QUERY_LIMIT 100
+
+@interface FileBucketPager ()
+
+@property (nonatomic, strong) KiiFileBucket *bucket;
+@property (nonatomic, strong) KiiClause *clause;
+
+// cursor: the sort value of the last file returned, and the uuids that
+// shared it so a >= query does not repeat them
+@property (nonatomic, strong) NSNumber *cursorValue;
+@property (nonatomic, strong) NSMutableSet *cursorUUIDs;
+@property (nonatomic, assign) BOOL exhausted;
+
+@property (nonatomic, strong) dispatch_group_t prefetchGroup;
+@property (nonatomic, strong) NSArray *prefetchedFiles;
+@property (nonatomic, strong) NSError *prefetchedError;
+
+@end
+
+@interface FileBucketEnumerator : NSEnumerator
+
+@property (nonatomic, strong) FileBucketPager *pager;
+@property (nonatomic, strong) NSArray *page;
+@property (nonatomic, assign) NSUInteger index;
+
+- (id) initWithPager:(FileBucketPager*)pager;
+
+@end
+
+
+@implementation FileBucketPager
+
++ (FileBucketPager*) pagerWithBucket:(KiiFileBucket*)bucket andClause:(KiiClause*)clause {
+    FileBucketPager *pager = [[FileBucketPager alloc] init];
+    pager.bucket = bucket;
+    pager.clause = clause;
+    return pager;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _pageSize = KII_MAX_QUERY_LIMIT;
+        _sortField = @"_created";
+        _trashedField = @"_trashed";
+        _trashedFilter = FileTrashedFilterAny;
+        _prefetch = TRUE;
+        _cursorUUIDs = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (void) setSortField:(NSString*)sortField {
+
+    // the cursor is read back from the KiiFile, which only exposes these two
+    NSAssert([sortField isEqualToString:@"_created"] || [sortField isEqualToString:@"_modified"],
+             @"FileBucketPager can only page on _created or _modified, not %@", sortField);
+
+    if([sortField isEqualToString:@"_created"] || [sortField isEqualToString:@"_modified"]) {
+        _sortField = sortField;
+    }
+}
+
+- (BOOL) hasMore {
+    @synchronized(self) {
+        // a prefetch in flight always holds a page, even if it turns out empty
+        return !_exhausted || _prefetchGroup != nil;
+    }
+}
+
+- (void) reset {
+    @synchronized(self) {
+        if(_prefetchGroup != nil) {
+            dispatch_group_wait(_prefetchGroup, DISPATCH_TIME_FOREVER);
+        }
+        _prefetchGroup = nil;
+        _prefetchedFiles = nil;
+        _prefetchedError = nil;
+        _cursorValue = nil;
+        [_cursorUUIDs removeAllObjects];
+        _exhausted = FALSE;
+    }
+}
+
+#pragma mark - fetching
+
++ (NSNumber*) sortValueForFile:(KiiFile*)file field:(NSString*)field {
+
+    // the server stores timestamps as milliseconds since the epoch
+    NSDate *date = [field isEqualToString:@"_modified"] ? file.modified : file.created;
+    return [NSNumber numberWithLongLong:llround([date timeIntervalSince1970] * 1000)];
+}
+
+- (KiiQuery*) queryForCursor:(NSNumber*)cursor strict:(BOOL)strict {
+
+    NSMutableArray *clauses = [NSMutableArray array];
+
+    if(_clause != nil) {
+        [clauses addObject:_clause];
+    }
+
+    if(_trashedFilter != FileTrashedFilterAny) {
+        BOOL trashed = (_trashedFilter == FileTrashedFilterTrashedOnly);
+        [clauses addObject:[KiiClause equals:_trashedField value:[NSNumber numberWithBool:trashed]]];
+    }
+
+    if(cursor != nil) {
+        [clauses addObject:strict ? [KiiClause greaterThan:_sortField value:cursor]
+                                  : [KiiClause greaterThanOrEqual:_sortField value:cursor]];
+    }
+
+    KiiClause *combined = nil;
+    if(clauses.count == 1) {
+        combined = [clauses objectAtIndex:0];
+    } else if(clauses.count == 2) {
+        combined = [KiiClause and:[clauses objectAtIndex:0], [clauses objectAtIndex:1], nil];
+    } else if(clauses.count == 3) {
+        combined = [KiiClause and:[clauses objectAtIndex:0], [clauses objectAtIndex:1], [clauses objectAtIndex:2], nil];
+    }
+
+    KiiQuery *query = [KiiQuery queryWithClause:combined];
+    [query sortByAsc:_sortField];
+    query.limit = MAX(1, MIN(_pageSize, KII_MAX_QUERY_LIMIT));
+
+    return query;
+}
+
+// Runs one query and advances the cursor. Never called concurrently - the
+// prefetch is always waited on before another fetch starts.
+- (NSArray*) fetchPage:(NSError**)error {
+
+    if(_exhausted) {
+        return [NSArray array];
+    }
+
+    int limit = MAX(1, MIN(_pageSize, KII_MAX_QUERY_LIMIT));
+    BOOL strict = FALSE;
+
+    while(TRUE) {
+
+        NSArray *results = [_bucket executeQuerySynchronous:[self queryForCursor:_cursorValue strict:strict] withError:error];
+        if(*error != nil) {
+            return nil;
+        }
+
+        if(results.count < (NSUInteger)limit) {
+            _exhausted = TRUE;
+        }
+
+        NSMutableArray *page = [NSMutableArray arrayWithCapacity:results.count];
+        for(KiiFile *file in results) {
+
+            if(file.uuid != nil && [_cursorUUIDs containsObject:file.uuid]) {
+                continue;
+            }
+
+            NSNumber *value = [FileBucketPager sortValueForFile:file field:_sortField];
+            if(_cursorValue == nil || ![value isEqualToNumber:_cursorValue]) {
+                _cursorValue = value;
+                [_cursorUUIDs removeAllObjects];
+            }
+            if(file.uuid != nil) {
+                [_cursorUUIDs addObject:file.uuid];
+            }
+
+            [page addObject:file];
+        }
+
+        // a full page made only of files sharing the cursor value would loop
+        // forever on >= - step past the value instead
+        if(page.count == 0 && !_exhausted && !strict) {
+            strict = TRUE;
+            continue;
+        }
+
+        return page;
+    }
+}
+
+- (void) startPrefetch {
+
+    if(!_prefetch || _exhausted) {
+        return;
+    }
+
+    _prefetchGroup = dispatch_group_create();
+
+    __weak FileBucketPager *weakSelf = self;
+    dispatch_group_async(_prefetchGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        FileBucketPager *strongSelf = weakSelf;
+        NSError *error = nil;
+        strongSelf.prefetchedFiles = [strongSelf fetchPage:&error];
+        strongSelf.prefetchedError = error;
+    });
+}
+
+- (NSArray*) nextPageSynchronous:(NSError**)error {
+
+    @synchronized(self) {
+
+        NSError *fetchError = nil;
+        NSArray *page = nil;
+
+        if(_prefetchGroup != nil) {
+            dispatch_group_wait(_prefetchGroup, DISPATCH_TIME_FOREVER);
+            page = _prefetchedFiles;
+            fetchError = _prefetchedError;
+            _prefetchGroup = nil;
+            _prefetchedFiles = nil;
+            _prefetchedError = nil;
+        } else {
+            page = [self fetchPage:&fetchError];
+        }
+
+        if(error != NULL) {
+            *error = fetchError;
+        }
+
+        if(fetchError == nil) {
+            [self startPrefetch];
+        }
+
+        return page;
+    }
+}
+
+- (void) nextPage:(FilePageCompletion)completion {
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        NSError *error = nil;
+        NSArray *page = [self nextPageSynchronous:&error];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(page, error);
+        });
+    });
+}
+
+#pragma mark - enumeration
+
+- (NSEnumerator*) fileEnumerator {
+    return [[FileBucketEnumerator alloc] initWithPager:self];
+}
+
+@end
+
+
+@implementation FileBucketEnumerator
+
+- (id) initWithPager:(FileBucketPager*)pager {
+    self = [super init];
+    if(self) {
+        _pager = pager;
+    }
+    return self;
+}
+
+- (id) nextObject {
+
+    while(_index >= _page.count) {
+
+        if(!_pager.hasMore) {
+            return nil;
+        }
+
+        NSError *error = nil;
+        _page = [_pager nextPageSynchronous:&error];
+        _index = 0;
+
+        // an empty page is not the end while the pager still has more
+        if(error != nil) {
+            return nil;
+        }
+    }
+
+    return [_page objectAtIndex:_index++];
+}
+
+@end
@@ -0,0 +1,85 @@
+//
+//  FileCompressor.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiFile;
+
+/** The value of KiiFile optional that marks a body compressed by FileCompressor */
+extern NSString * const FileCompressorMarker;
+
+/** Per-transfer compression statistics */
+@interface FileCompressionStats : NSObject
+
+/** The size of the uncompressed body, in bytes */
+@property (nonatomic, assign) long long originalBytes;
+
+/** The number of bytes sent or received over the network */
+@property (nonatomic, assign) long long transferredBytes;
+
+/** The CPU time spent compressing or decompressing, in seconds */
+@property (nonatomic, assign) NSTimeInterval cpuTime;
+
+/** transferredBytes / originalBytes. 1 if the body was not compressed */
+@property (readonly) double ratio;
+
+@end
+
+
+/** Opt-in gzip compression of text-like KiiFile bodies
+
+ When enabled, bodies with a text-like mime type (plain text, JSON, XML, CSV and JavaScript) are gzipped to a temporary file before uploading and inflated again after downloading. The compressed body is uploaded under a .gz name, so the server stores it with a gzip Content-Type and a size that is the compressed size; the title is set to the original name if it was not set. Compressed files are marked by setting their optional field to FileCompressorMarker, so files whose optional field is already in use are always sent raw. Downloads are inflated only when the file carries the marker and a gzip Content-Type; any other file, including gzip archives uploaded by other clients, is returned as-is.
+
+ Compressed files are not readable as their original type by other clients, or by KiiFile getFileBodySynchronous:withError:, which return the gzip bytes. Only enable compression for files that are always read back through this class, never for buckets shared with other apps.
+
+ Other mime types are always transferred raw.
+ */
+@interface FileCompressor : NSObject
+
+/** Whether uploads are compressed. Defaults to FALSE. Downloads of compressed files are always inflated */
+@property (nonatomic, assign) BOOL enabled;
+
+/** The zlib compression level [1, 9]. Defaults to 6 */
+@property (nonatomic, assign) int compressionLevel;
+
+/** The shared file compressor
+
+ @return The process-wide FileCompressor instance
+ */
++ (FileCompressor*) sharedCompressor;
+
+
+/** Check whether a mime type is worth compressing
+
+ @param mimeType The mime type to check
+ @return TRUE if the mime type is text-like
+ */
++ (BOOL) isCompressibleMimeType:(NSString*)mimeType;
+
+
+/** Saves the file data, compressing the body if possible
+
+ A drop-in replacement for KiiFile saveFileSynchronous:. This is a blocking method.
+ @param file The file to upload. Its localPath must be set
+ @param error An NSError object, passed by reference. If the error is nil, the request was successful
+ @return The compression statistics for this transfer, nil on failure
+ */
+- (FileCompressionStats*) saveFileSynchronous:(KiiFile*)file withError:(NSError**)error;
+
+
+/** Retrieves the file body from the server, inflating it if it was compressed
+
+ A drop-in replacement for KiiFile getFileBodySynchronous:withError:. The file metadata is loaded first if its mimeType is not known. This is a blocking method.
+ @param file The file to download
+ @param toPath The path of the file the uncompressed body will be written to
+ @param error An NSError object, passed by reference. If the error is nil, the request was successful
+ @return The compression statistics for this transfer, nil on failure
+ */
+- (FileCompressionStats*) getFileBodySynchronous:(KiiFile*)file toPath:(NSString*)toPath withError:(NSError**)error;
+
+@end
@@ -0,0 +1,348 @@
+//
+//  FileCompressor.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "FileCompressor.h"
+
+#import <KiiSDK/Kii.h>
+#import <MobileCoreServices/MobileCoreServices.h>
+#import <mach/mach.h>
+#import <zlib.h>
+
+#import "NSError+KiiErrorCode.h"
+
+#define COMPRESSION_CHUNK_SIZE (64 * 1024)
+
+NSString * const FileCompressorMarker = @"FileCompressor:gzip";
+
+static NSTimeInterval CurrentThreadCPUTime(void) {
+
+    thread_basic_info_data_t info;
+    mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+    mach_port_t thread = mach_thread_self();
+
+    kern_return_t kr = thread_info(thread, THREAD_BASIC_INFO, (thread_info_t)&info, &count);
+    mach_port_deallocate(mach_task_self(), thread);
+
+    if(kr != KERN_SUCCESS) {
+        return 0;
+    }
+
+    return info.user_time.seconds + info.user_time.microseconds / 1e6
+         + info.system_time.seconds + info.system_time.microseconds / 1e6;
+}
+
+static long long FileSizeAtPath(NSString *path) {
+    return [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil] fileSize];
+}
+
+@implementation FileCompressionStats
+
+- (double) ratio {
+    return (_originalBytes > 0) ? (double)_transferredBytes / (double)_originalBytes : 1;
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"<FileCompressionStats original=%lld transferred=%lld ratio=%.3f cpu=%.3fs>",
+            _originalBytes, _transferredBytes, self.ratio, _cpuTime];
+}
+
+@end
+
+
+@implementation FileCompressor
+
++ (FileCompressor*) sharedCompressor {
+    static FileCompressor *sharedCompressor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCompressor = [[FileCompressor alloc] init];
+    });
+    return sharedCompressor;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _enabled = FALSE;
+        _compressionLevel = 6;
+    }
+    return self;
+}
+
+#pragma mark - mime types
+
++ (NSString*) mimeTypeForPath:(NSString*)path {
+
+    NSString *extension = [path pathExtension];
+    if(extension.length == 0) {
+        return nil;
+    }
+
+    CFStringRef uti = UTTypeCreatePreferredIdentifierForTag(kUTTagClassFilenameExtension, (__bridge CFStringRef)extension, NULL);
+    if(uti == NULL) {
+        return nil;
+    }
+
+    CFStringRef mimeType = UTTypeCopyPreferredTagWithClass(uti, kUTTagClassMIMEType);
+    CFRelease(uti);
+
+    return (__bridge_transfer NSString*)mimeType;
+}
+
++ (BOOL) isCompressibleMimeType:(NSString*)mimeType {
+
+    if(mimeType == nil) {
+        return FALSE;
+    }
+
+    NSString *type = [[[mimeType componentsSeparatedByString:@";"] objectAtIndex:0] lowercaseString];
+
+    if([type hasPrefix:@"text/"] || [type hasSuffix:@"+json"] || [type hasSuffix:@"+xml"]) {
+        return TRUE;
+    }
+
+    static NSSet *compressible = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        compressible = [NSSet setWithObjects:@"application/json", @"application/xml", @"application/javascript",
+                        @"application/x-javascript", @"application/csv", @"application/x-csv", nil];
+    });
+
+    return [compressible containsObject:type];
+}
+
+#pragma mark - zlib
+
+// Streams src through zlib into dst in fixed-size chunks so large bodies are
+// never held in memory. Returns FALSE on any I/O or zlib error.
++ (BOOL) transformFile:(NSString*)srcPath toFile:(NSString*)dstPath deflate:(BOOL)deflating level:(int)level {
+
+    FILE *src = fopen([srcPath fileSystemRepresentation], "rb");
+    if(src == NULL) {
+        return FALSE;
+    }
+
+    FILE *dst = fopen([dstPath fileSystemRepresentation], "wb");
+    if(dst == NULL) {
+        fclose(src);
+        return FALSE;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+
+    // windowBits + 16 writes a gzip wrapper, + 32 auto-detects it on inflate
+    int ret = deflating ? deflateInit2(&stream, level, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY)
+                        : inflateInit2(&stream, MAX_WBITS + 32);
+    if(ret != Z_OK) {
+        fclose(src);
+        fclose(dst);
+        return FALSE;
+    }
+
+    unsigned char *inBuf = malloc(COMPRESSION_CHUNK_SIZE);
+    unsigned char *outBuf = malloc(COMPRESSION_CHUNK_SIZE);
+    BOOL success = TRUE;
+    BOOL finished = FALSE;
+
+    while(success && !finished) {
+
+        stream.avail_in = (uInt)fread(inBuf, 1, COMPRESSION_CHUNK_SIZE, src);
+        stream.next_in = inBuf;
+
+        if(ferror(src)) {
+            success = FALSE;
+            break;
+        }
+
+        int flush = feof(src) ? Z_FINISH : Z_NO_FLUSH;
+
+        do {
+            stream.avail_out = COMPRESSION_CHUNK_SIZE;
+            stream.next_out = outBuf;
+
+            ret = deflating ? deflate(&stream, flush) : inflate(&stream, Z_NO_FLUSH);
+            if(ret == Z_STREAM_ERROR || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR || ret == Z_NEED_DICT) {
+                success = FALSE;
+                break;
+            }
+
+            size_t produced = COMPRESSION_CHUNK_SIZE - stream.avail_out;
+            if(fwrite(outBuf, 1, produced, dst) != produced) {
+                success = FALSE;
+                break;
+            }
+
+        } while(stream.avail_out == 0);
+
+        if(ret == Z_STREAM_END) {
+            finished = TRUE;
+        } else if(flush == Z_FINISH && !deflating) {
+            // input ran out before the gzip trailer
+            success = FALSE;
+        } else if(flush == Z_FINISH) {
+            finished = TRUE;
+        }
+    }
+
+    if(deflating) {
+        deflateEnd(&stream);
+    } else {
+        inflateEnd(&stream);
+    }
+
+    free(inBuf);
+    free(outBuf);
+    fclose(src);
+    if(fclose(dst) != 0) {
+        success = FALSE;
+    }
+
+    return success;
+}
+
++ (BOOL) isGzipMimeType:(NSString*)mimeType {
+
+    if(mimeType == nil) {
+        return FALSE;
+    }
+
+    NSString *type = [[[mimeType componentsSeparatedByString:@";"] objectAtIndex:0] lowercaseString];
+    return [type isEqualToString:@"application/gzip"] || [type isEqualToString:@"application/x-gzip"];
+}
+
+#pragma mark - transfers
+
+- (FileCompressionStats*) saveFileSynchronous:(KiiFile*)file withError:(NSError**)error {
+
+    NSString *originalPath = file.localPath;
+    FileCompressionStats *stats = [[FileCompressionStats alloc] init];
+    stats.originalBytes = FileSizeAtPath(originalPath);
+
+    NSString *uploadPath = originalPath;
+
+    // the marker lives in the optional field, so a file that already uses it
+    // for something else is sent raw
+    NSString *originalOptional = file.optional;
+    BOOL markable = (originalOptional == nil || [originalOptional isEqualToString:FileCompressorMarker]);
+
+    if(_enabled && markable && [FileCompressor isCompressibleMimeType:[FileCompressor mimeTypeForPath:originalPath]]) {
+
+        // the .gz name makes the SDK store a gzip Content-Type
+        NSString *tmpDir = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSProcessInfo processInfo] globallyUniqueString]];
+        [[NSFileManager defaultManager] createDirectoryAtPath:tmpDir withIntermediateDirectories:YES attributes:nil error:nil];
+        NSString *compressedPath = [tmpDir stringByAppendingPathComponent:[[originalPath lastPathComponent] stringByAppendingPathExtension:@"gz"]];
+
+        NSTimeInterval cpuStart = CurrentThreadCPUTime();
+        BOOL compressed = [FileCompressor transformFile:originalPath toFile:compressedPath deflate:TRUE level:_compressionLevel];
+        stats.cpuTime = CurrentThreadCPUTime() - cpuStart;
+
+        // not worth it - send the raw body instead
+        if(compressed && FileSizeAtPath(compressedPath) < stats.originalBytes) {
+            uploadPath = compressedPath;
+        } else {
+            [[NSFileManager defaultManager] removeItemAtPath:tmpDir error:nil];
+        }
+    }
+
+    if(uploadPath != originalPath) {
+
+        // keep the listed name free of the .gz suffix
+        if(file.title == nil) {
+            file.title = [originalPath lastPathComponent];
+        }
+
+        file.optional = FileCompressorMarker;
+
+    } else if(markable) {
+
+        // a raw body replacing a compressed one must not be inflated
+        file.optional = nil;
+    }
+
+    NSError *saveError = nil;
+    file.localPath = uploadPath;
+    [file saveFileSynchronous:&saveError];
+    file.localPath = originalPath;
+
+    if(saveError != nil) {
+        file.optional = originalOptional;
+    }
+
+    stats.transferredBytes = FileSizeAtPath(uploadPath);
+
+    if(uploadPath != originalPath) {
+        [[NSFileManager defaultManager] removeItemAtPath:[uploadPath stringByDeletingLastPathComponent] error:nil];
+    }
+
+    if(error != NULL) {
+        *error = saveError;
+    }
+
+    return (saveError == nil) ? stats : nil;
+}
+
+- (FileCompressionStats*) getFileBodySynchronous:(KiiFile*)file toPath:(NSString*)toPath withError:(NSError**)error {
+
+    // the marker and the stored Content-Type must both be known
+    NSError *downloadError = nil;
+    if(file.mimeType == nil) {
+        [file getFileMetadataSynchronous:&downloadError];
+    }
+
+    NSString *downloadPath = [toPath stringByAppendingPathExtension:[[NSProcessInfo processInfo] globallyUniqueString]];
+
+    if(downloadError == nil) {
+        [file getFileBodySynchronous:downloadPath withError:&downloadError];
+    }
+
+    if(error != NULL) {
+        *error = downloadError;
+    }
+
+    if(downloadError != nil) {
+        [[NSFileManager defaultManager] removeItemAtPath:downloadPath error:nil];
+        return nil;
+    }
+
+    FileCompressionStats *stats = [[FileCompressionStats alloc] init];
+    stats.transferredBytes = FileSizeAtPath(downloadPath);
+
+    NSFileManager *fm = [NSFileManager defaultManager];
+    [fm removeItemAtPath:toPath error:nil];
+
+    // only bodies this class compressed are inflated - any other gzip file,
+    // such as an archive uploaded by another client, is returned as-is
+    BOOL compressed = [file.optional isEqualToString:FileCompressorMarker] && [FileCompressor isGzipMimeType:file.mimeType];
+
+    if(compressed) {
+
+        NSTimeInterval cpuStart = CurrentThreadCPUTime();
+        BOOL inflated = [FileCompressor transformFile:downloadPath toFile:toPath deflate:FALSE level:0];
+        stats.cpuTime = CurrentThreadCPUTime() - cpuStart;
+
+        [fm removeItemAtPath:downloadPath error:nil];
+
+        if(!inflated) {
+            [fm removeItemAtPath:toPath error:nil];
+            if(error != NULL) {
+                *error = [NSError kiiErrorWithCode:KiiErrorUnableToParseResponse];
+            }
+            return nil;
+        }
+
+    } else {
+        [fm moveItemAtPath:downloadPath toPath:toPath error:nil];
+    }
+
+    stats.originalBytes = FileSizeAtPath(toPath);
+
+    return stats;
+}
+
+@end
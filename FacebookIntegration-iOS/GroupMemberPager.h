@@ -0,0 +1,99 @@
+//
+//  GroupMemberPager.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiGroup;
+
+typedef void (^MemberPageCompletion)(NSArray *members, NSError *error);
+
+/** Paged access to the members of a large KiiGroup
+
+ KiiGroup getMemberListSynchronous: has no paging of its own, so the pager loads the member list once, then hands it out in pages of pageSize. The expensive part of showing a member list, refreshing each KiiUser, is done a page at a time through UserCache, and the page after the current one is refreshed in the background while the current one is shown.
+
+ For keeping a local roster current, changesInGroup:added:removed:andError: compares the server list against the roster saved on the previous call and reports only the difference, so callers only have to process the members that changed.
+ */
+@interface GroupMemberPager : NSObject
+
+/** The number of members per page. Defaults to 100 */
+@property (nonatomic, assign) int pageSize;
+
+/** Whether each page is refreshed through UserCache before it is returned. Defaults to TRUE */
+@property (nonatomic, assign) BOOL refreshMembers;
+
+/** Whether the following page is prepared in the background as soon as a page is returned. Defaults to TRUE */
+@property (nonatomic, assign) BOOL prefetch;
+
+/** FALSE once the last page has been returned */
+@property (readonly) BOOL hasMore;
+
+/** The total number of members, or NSNotFound before the first page is loaded */
+@property (readonly) NSUInteger memberCount;
+
+/** Create a pager over the members of a group
+
+ @param group The group whose members to page through
+ @return A new GroupMemberPager positioned before the first page
+ */
++ (GroupMemberPager*) pagerWithGroup:(KiiGroup*)group;
+
+
+/** Get the next page of members
+
+ The first call loads the member list from the server.
+ This is a blocking method
+ @param error An NSError object, set to nil, to test for errors
+ @return An array of KiiUser objects. Empty once there are no more members
+ */
+- (NSArray*) nextPageSynchronous:(NSError**)error;
+
+
+/** Get the next page of members
+
+ This is a non-blocking method
+ @param completion The block called on the main thread with the page of members, or an error
+ */
+- (void) nextPage:(MemberPageCompletion)completion;
+
+
+/** A streaming enumerator over every remaining member
+
+ Pages are loaded as the enumerator is advanced, so nextObject may block on the network - use it from a background thread. Enumeration ends early if a page fails to load.
+ @return An NSEnumerator of KiiUser objects
+ */
+- (NSEnumerator*) memberEnumerator;
+
+
+/** Discard the loaded member list and any prepared page, and start again from the first page */
+- (void) reset;
+
+
+/** Find the members added to and removed from a group since the last call
+
+ The first call for a group reports every member as added. The new roster is saved only when the list was loaded successfully. Rosters are kept per user, and nothing is saved while logged out or for a group without an objectURI.
+ This is a blocking method
+ @param group The group to compare
+ @param added Set to an array of KiiUser objects that joined the group
+ @param removed Set to an array of KiiUser objects, built from their stored objectURI, that left the group
+ @param error An NSError object, set to nil, to test for errors
+ @return TRUE if the comparison succeeded
+ */
++ (BOOL) changesInGroup:(KiiGroup*)group added:(NSArray**)added removed:(NSArray**)removed andError:(NSError**)error;
+
+
+/** Forget the saved roster of a group, so the next comparison starts over
+
+ @param group The group to forget
+ */
++ (void) forgetRosterForGroup:(KiiGroup*)group;
+
+
+/** Delete every saved roster of the current user. Called by SessionStore clearSession */
++ (void) removeAllRosters;
+
+@end
@@ -0,0 +1,316 @@
+//
+//  GroupMemberPager.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "GroupMemberPager.h"
+
+#import <KiiSDK/Kii.h>
+
+#import "MembershipIndex.h"
+#import "UserCache.h"
+
+@interface GroupMemberPager ()
+
+@property (nonatomic, strong) KiiGroup *group;
+@property (nonatomic, strong) NSArray *members;
+@property (nonatomic, assign) NSUInteger offset;
+
+@property (nonatomic, strong) dispatch_group_t prefetchGroup;
+@property (nonatomic, strong) NSArray *prefetchedMembers;
+
+@end
+
+@interface GroupMemberEnumerator : NSEnumerator
+
+@property (nonatomic, strong) GroupMemberPager *pager;
+@property (nonatomic, strong) NSArray *page;
+@property (nonatomic, assign) NSUInteger index;
+
+- (id) initWithPager:(GroupMemberPager*)pager;
+
+@end
+
+
+@implementation GroupMemberPager
+
++ (GroupMemberPager*) pagerWithGroup:(KiiGroup*)group {
+    GroupMemberPager *pager = [[GroupMemberPager alloc] init];
+    pager.group = group;
+    return pager;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _pageSize = 100;
+        _refreshMembers = TRUE;
+        _prefetch = TRUE;
+    }
+    return self;
+}
+
+- (BOOL) hasMore {
+    @synchronized(self) {
+        return _members == nil || _offset < _members.count || _prefetchGroup != nil;
+    }
+}
+
+- (NSUInteger) memberCount {
+    @synchronized(self) {
+        return (_members != nil) ? _members.count : NSNotFound;
+    }
+}
+
+- (void) reset {
+    @synchronized(self) {
+        if(_prefetchGroup != nil) {
+            dispatch_group_wait(_prefetchGroup, DISPATCH_TIME_FOREVER);
+        }
+        _prefetchGroup = nil;
+        _prefetchedMembers = nil;
+        _members = nil;
+        _offset = 0;
+    }
+}
+
+#pragma mark - paging
+
+// Cuts the next page off the loaded list and advances the offset. Never
+// called concurrently - the prefetch is always waited on first.
+- (NSArray*) takePage {
+
+    NSUInteger size = MAX(_pageSize, 1);
+    NSRange range = NSMakeRange(_offset, MIN(size, _members.count - _offset));
+    _offset += range.length;
+
+    NSArray *page = [_members subarrayWithRange:range];
+    if(_refreshMembers && page.count > 0) {
+        // refresh failures leave the member as listed, which still has its URI
+        page = [[UserCache sharedCache] refreshUsers:page withErrors:nil];
+    }
+
+    return page;
+}
+
+- (void) startPrefetch {
+
+    if(!_prefetch || _offset >= _members.count) {
+        return;
+    }
+
+    _prefetchGroup = dispatch_group_create();
+
+    __weak GroupMemberPager *weakSelf = self;
+    dispatch_group_async(_prefetchGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        GroupMemberPager *strongSelf = weakSelf;
+        strongSelf.prefetchedMembers = [strongSelf takePage];
+    });
+}
+
+- (NSArray*) nextPageSynchronous:(NSError**)error {
+
+    @synchronized(self) {
+
+        NSError *fetchError = nil;
+        NSArray *page = nil;
+
+        if(_prefetchGroup != nil) {
+            dispatch_group_wait(_prefetchGroup, DISPATCH_TIME_FOREVER);
+            page = _prefetchedMembers;
+            _prefetchGroup = nil;
+            _prefetchedMembers = nil;
+        } else {
+            if(_members == nil) {
+                NSArray *members = [_group getMemberListSynchronous:&fetchError];
+                if(fetchError == nil) {
+                    _members = (members != nil) ? members : [NSArray array];
+                    _offset = 0;
+                    [[MembershipIndex sharedIndex] setMembers:_members ofGroup:_group];
+                }
+            }
+            page = (fetchError == nil) ? [self takePage] : nil;
+        }
+
+        if(error != NULL) {
+            *error = fetchError;
+        }
+
+        if(fetchError == nil) {
+            [self startPrefetch];
+        }
+
+        return page;
+    }
+}
+
+- (void) nextPage:(MemberPageCompletion)completion {
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        NSError *error = nil;
+        NSArray *page = [self nextPageSynchronous:&error];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(page, error);
+        });
+    });
+}
+
+#pragma mark - enumeration
+
+- (NSEnumerator*) memberEnumerator {
+    return [[GroupMemberEnumerator alloc] initWithPager:self];
+}
+
+#pragma mark - rosters
+
+// Each user's rosters live in their own file, so one user's changes are
+// never reported against another's. nil while logged out.
++ (NSString*) rosterPath {
+
+    NSString *current = [KiiUser currentUser].objectURI;
+    if(current == nil) {
+        return nil;
+    }
+
+    NSString *support = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+    [[NSFileManager defaultManager] createDirectoryAtPath:support
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+
+    NSCharacterSet *unsafe = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+    NSString *name = [[current componentsSeparatedByCharactersInSet:unsafe] componentsJoinedByString:@"_"];
+    return [support stringByAppendingPathComponent:[NSString stringWithFormat:@"GroupRosters-%@.plist", name]];
+}
+
++ (BOOL) changesInGroup:(KiiGroup*)group added:(NSArray**)added removed:(NSArray**)removed andError:(NSError**)error {
+
+    NSError *listError = nil;
+    NSArray *members = [group getMemberListSynchronous:&listError];
+
+    if(error != NULL) {
+        *error = listError;
+    }
+
+    if(listError != nil) {
+        return FALSE;
+    }
+
+    [[MembershipIndex sharedIndex] setMembers:members ofGroup:group];
+
+    NSMutableArray *joined = [NSMutableArray array];
+    NSMutableSet *current = [NSMutableSet setWithCapacity:members.count];
+
+    @synchronized([GroupMemberPager class]) {
+
+        NSString *path = [GroupMemberPager rosterPath];
+        NSMutableDictionary *rosters = (path != nil) ? [NSMutableDictionary dictionaryWithContentsOfFile:path] : nil;
+        if(rosters == nil) {
+            rosters = [NSMutableDictionary dictionary];
+        }
+
+        // a group that was never saved has no roster to compare against
+        NSString *groupURI = group.objectURI;
+        NSMutableSet *previous = [NSMutableSet setWithArray:(groupURI != nil) ? [rosters objectForKey:groupURI] : nil];
+
+        for(KiiUser *member in members) {
+            if(member.objectURI == nil) {
+                continue;
+            }
+            [current addObject:member.objectURI];
+            if(![previous containsObject:member.objectURI]) {
+                [joined addObject:member];
+            }
+        }
+
+        [previous minusSet:current];
+
+        if(removed != NULL) {
+            NSMutableArray *left = [NSMutableArray arrayWithCapacity:previous.count];
+            for(NSString *uri in previous) {
+                [left addObject:[KiiUser userWithURI:uri]];
+            }
+            *removed = left;
+        }
+
+        if(path != nil && groupURI != nil) {
+            [rosters setObject:[current allObjects] forKey:groupURI];
+            [rosters writeToFile:path atomically:YES];
+        }
+    }
+
+    if(added != NULL) {
+        *added = joined;
+    }
+
+    return TRUE;
+}
+
++ (void) forgetRosterForGroup:(KiiGroup*)group {
+
+    @synchronized([GroupMemberPager class]) {
+
+        NSString *path = [GroupMemberPager rosterPath];
+        if(path == nil || group.objectURI == nil) {
+            return;
+        }
+
+        NSMutableDictionary *rosters = [NSMutableDictionary dictionaryWithContentsOfFile:path];
+
+        if([rosters objectForKey:group.objectURI] != nil) {
+            [rosters removeObjectForKey:group.objectURI];
+            [rosters writeToFile:path atomically:YES];
+        }
+    }
+}
+
++ (void) removeAllRosters {
+
+    @synchronized([GroupMemberPager class]) {
+
+        NSString *path = [GroupMemberPager rosterPath];
+        if(path != nil) {
+            [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+        }
+    }
+}
+
+@end
+
+
+@implementation GroupMemberEnumerator
+
+- (id) initWithPager:(GroupMemberPager*)pager {
+    self = [super init];
+    if(self) {
+        _pager = pager;
+    }
+    return self;
+}
+
+- (id) nextObject {
+
+    while(_index >= _page.count) {
+
+        if(!_pager.hasMore) {
+            return nil;
+        }
+
+        NSError *error = nil;
+        _page = [_pager nextPageSynchronous:&error];
+        _index = 0;
+
+        if(error != nil || _page.count == 0) {
+            return nil;
+        }
+    }
+
+    return [_page objectAtIndex:_index++];
+}
+
+@end
@@ -0,0 +1,78 @@
+//
+//  GroupMembershipBatcher.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiGroup, KiiUser;
+
+/** Called on the main thread when a save finishes. errors maps the objectURI of each failed user to the error of its chunk */
+typedef void (^GroupMembershipCompletion)(NSArray *succeeded, NSArray *failed, NSDictionary *errors);
+
+/** Saves large membership changes to a KiiGroup in chunks
+
+ KiiGroup addUser: and removeUser: collect every change in one group object, and saveSynchronous: pushes them all as a single all-or-nothing save. The batcher instead records changes locally, where adding and then removing the same user (or the reverse) cancels out, and then saves them in chunks of chunkSize. Each chunk goes through its own KiiGroup handle for the same group, refreshed from the server before it is saved, and up to `concurrency` chunks are in flight at once. A failed chunk fails only its own users. Saved chunks are recorded in MembershipIndex.
+ */
+@interface GroupMembershipBatcher : NSObject
+
+/** The group being modified */
+@property (nonatomic, readonly) KiiGroup *group;
+
+/** The number of membership changes sent per save. Defaults to 50 */
+@property (nonatomic, assign) NSUInteger chunkSize;
+
+/** The maximum number of chunks saved in parallel. Defaults to 2 */
+@property (nonatomic, assign) NSUInteger concurrency;
+
+/** The number of changes waiting to be saved */
+@property (nonatomic, readonly) NSUInteger pendingCount;
+
+/** Create a batcher for a group
+
+ @param group A group that already exists on the server
+ @return A GroupMembershipBatcher with no pending changes
+ */
++ (GroupMembershipBatcher*) batcherForGroup:(KiiGroup*)group;
+
+
+/** Record a user to add on the next save
+
+ Cancels a pending removal of the same user.
+ @param user The user to add
+ @return FALSE if the user has no objectURI and was ignored
+ */
+- (BOOL) addUser:(KiiUser*)user;
+
+
+/** Record a user to remove on the next save
+
+ Cancels a pending addition of the same user.
+ @param user The user to remove
+ @return FALSE if the user has no objectURI and was ignored
+ */
+- (BOOL) removeUser:(KiiUser*)user;
+
+
+/** Save all pending changes in chunks
+
+ Pending changes are taken when the save starts; changes recorded while it runs wait for the next save. Users in failed chunks are not queued again.
+ This is a blocking method.
+ @param succeeded An NSArray of KiiUser objects whose change was saved
+ @param failed An NSArray of KiiUser objects whose change failed
+ @param error An NSError object, set to nil, to test for errors. The error of the first failed chunk if any failed
+ */
+- (void) saveSynchronous:(NSArray**)succeeded failed:(NSArray**)failed andError:(NSError**)error;
+
+
+/** Save all pending changes in chunks
+
+ This is a non-blocking method.
+ @param completion The block called on the main thread with the per-user results
+ */
+- (void) saveWithCompletion:(GroupMembershipCompletion)completion;
+
+@end
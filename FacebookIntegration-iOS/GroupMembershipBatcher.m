@@ -0,0 +1,211 @@
+//
+//  GroupMembershipBatcher.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "GroupMembershipBatcher.h"
+
+#import <KiiSDK/Kii.h>
+
+#import "MembershipIndex.h"
+
+@interface GroupMembershipBatcher ()
+
+@property (nonatomic, strong) KiiGroup *group;
+@property (nonatomic, strong) NSMutableDictionary *additions;
+@property (nonatomic, strong) NSMutableDictionary *removals;
+
+@end
+
+@implementation GroupMembershipBatcher
+
++ (GroupMembershipBatcher*) batcherForGroup:(KiiGroup*)group {
+    GroupMembershipBatcher *batcher = [[GroupMembershipBatcher alloc] init];
+    batcher.group = group;
+    return batcher;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _chunkSize = 50;
+        _concurrency = 2;
+        _additions = [NSMutableDictionary dictionary];
+        _removals = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSUInteger) pendingCount {
+    @synchronized(self) {
+        return _additions.count + _removals.count;
+    }
+}
+
+#pragma mark - changes
+
+- (BOOL) addUser:(KiiUser*)user {
+
+    // changes are keyed by URI, and a user without one was never saved
+    if(user.objectURI == nil) {
+        return FALSE;
+    }
+
+    @synchronized(self) {
+        if([_removals objectForKey:user.objectURI] != nil) {
+            [_removals removeObjectForKey:user.objectURI];
+        } else {
+            [_additions setObject:user forKey:user.objectURI];
+        }
+    }
+    return TRUE;
+}
+
+- (BOOL) removeUser:(KiiUser*)user {
+
+    if(user.objectURI == nil) {
+        return FALSE;
+    }
+
+    @synchronized(self) {
+        if([_additions objectForKey:user.objectURI] != nil) {
+            [_additions removeObjectForKey:user.objectURI];
+        } else {
+            [_removals setObject:user forKey:user.objectURI];
+        }
+    }
+    return TRUE;
+}
+
+#pragma mark - saving
+
+- (void) saveSynchronous:(NSArray**)succeeded failed:(NSArray**)failed andError:(NSError**)error {
+    [self saveSynchronous:succeeded failed:failed errors:nil andError:error];
+}
+
+- (void) saveSynchronous:(NSArray**)succeeded failed:(NSArray**)failed errors:(NSMutableDictionary*)errors andError:(NSError**)error {
+
+    NSArray *additions = nil;
+    NSArray *removals = nil;
+
+    @synchronized(self) {
+        additions = [_additions allValues];
+        removals = [_removals allValues];
+        [_additions removeAllObjects];
+        [_removals removeAllObjects];
+    }
+
+    // one flat list of changes, additions first, cut into chunks
+    NSMutableArray *changes = [NSMutableArray array];
+    for(KiiUser *user in additions) {
+        [changes addObject:@[ user, @TRUE ]];
+    }
+    for(KiiUser *user in removals) {
+        [changes addObject:@[ user, @FALSE ]];
+    }
+
+    NSUInteger chunkSize = MAX(_chunkSize, 1);
+    NSUInteger chunks = (changes.count + chunkSize - 1) / chunkSize;
+
+    NSMutableArray *saved = [NSMutableArray array];
+    NSMutableArray *unsaved = [NSMutableArray array];
+    __block NSError *firstError = nil;
+
+    NSString *groupURI = _group.objectURI;
+    dispatch_semaphore_t slots = dispatch_semaphore_create(MAX(_concurrency, 1));
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+    for(NSUInteger c = 0; c < chunks; c++) {
+
+        NSRange range = NSMakeRange(c * chunkSize, MIN(chunkSize, changes.count - c * chunkSize));
+        NSArray *chunk = [changes subarrayWithRange:range];
+
+        dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+
+        dispatch_group_async(group, queue, ^{
+
+            // a separate handle per chunk so each save carries only its own
+            // changes. It is refreshed first, so the save never writes back a
+            // handle that knows nothing but the URI
+            KiiGroup *handle = [KiiGroup groupWithURI:groupURI];
+            NSError *chunkError = nil;
+            [handle refreshSynchronous:&chunkError];
+
+            NSMutableArray *users = [NSMutableArray arrayWithCapacity:chunk.count];
+            NSMutableArray *added = [NSMutableArray array];
+            NSMutableArray *removed = [NSMutableArray array];
+
+            for(NSArray *change in chunk) {
+                KiiUser *user = [change objectAtIndex:0];
+                if([[change objectAtIndex:1] boolValue]) {
+                    [handle addUser:user];
+                    [added addObject:user];
+                } else {
+                    [handle removeUser:user];
+                    [removed addObject:user];
+                }
+                [users addObject:user];
+            }
+
+            if(chunkError == nil) {
+                [handle saveSynchronous:&chunkError];
+            }
+
+            if(chunkError == nil) {
+                [[MembershipIndex sharedIndex] addUsers:added toGroup:groupURI];
+                [[MembershipIndex sharedIndex] removeUsers:removed fromGroup:groupURI];
+            }
+
+            @synchronized(saved) {
+                if(chunkError == nil) {
+                    [saved addObjectsFromArray:users];
+                } else {
+                    [unsaved addObjectsFromArray:users];
+                    for(KiiUser *user in users) {
+                        [errors setObject:chunkError forKey:user.objectURI];
+                    }
+                    if(firstError == nil) {
+                        firstError = chunkError;
+                    }
+                }
+            }
+
+            dispatch_semaphore_signal(slots);
+        });
+    }
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    if(succeeded != NULL) {
+        *succeeded = saved;
+    }
+    if(failed != NULL) {
+        *failed = unsaved;
+    }
+    if(error != NULL) {
+        *error = firstError;
+    }
+}
+
+- (void) saveWithCompletion:(GroupMembershipCompletion)completion {
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        NSArray *succeeded = nil;
+        NSArray *failed = nil;
+        NSMutableDictionary *errors = [NSMutableDictionary dictionary];
+        [self saveSynchronous:&succeeded failed:&failed errors:errors andError:nil];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if(completion != nil) {
+                completion(succeeded, failed, errors);
+            }
+        });
+    });
+}
+
+@end
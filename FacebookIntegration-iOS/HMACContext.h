@@ -0,0 +1,91 @@
+//
+//  HMACContext.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+typedef enum {
+    HMACAlgorithmSHA1,
+    HMACAlgorithmSHA256
+} HMACAlgorithm;
+
+/** A keyed HMAC signer for signing many messages with the same secret
+
+ The key is run through the HMAC key schedule once, when the context is created, so the inner and outer pads are not rebuilt for every message as they are with KiiUtilities hmacsha1:key:. Each digest starts from a copy of that prepared state. A context is immutable after creation and may be shared between threads.
+
+ Hashing is done by CommonCrypto, which uses the SHA instructions of the CPU where the device has them.
+ */
+@interface HMACContext : NSObject
+
+/** The algorithm this context signs with */
+@property (nonatomic, readonly) HMACAlgorithm algorithm;
+
+/** The length of a digest in bytes. 20 for SHA-1, 32 for SHA-256 */
+@property (nonatomic, readonly) size_t digestLength;
+
+/** Create a context from a raw key
+
+ @param key The secret key
+ @param algorithm The hash to sign with
+ @return A prepared HMACContext
+ */
++ (HMACContext*) contextWithKey:(NSData*)key andAlgorithm:(HMACAlgorithm)algorithm;
+
+
+/** Create a context from a string key, encoded as UTF-8
+
+ @param key The secret key
+ @param algorithm The hash to sign with
+ @return A prepared HMACContext
+ */
++ (HMACContext*) contextWithKeyString:(NSString*)key andAlgorithm:(HMACAlgorithm)algorithm;
+
+
+/** Initialize a context from a raw key buffer
+
+ @param key The secret key bytes
+ @param length The number of key bytes
+ @param algorithm The hash to sign with
+ @return A prepared HMACContext
+ */
+- (id) initWithKeyBytes:(const void*)key length:(size_t)length andAlgorithm:(HMACAlgorithm)algorithm;
+
+
+/** Sign a raw byte buffer without allocating
+
+ @param bytes The message bytes
+ @param length The number of message bytes
+ @param digest A buffer of at least digestLength bytes that receives the digest
+ */
+- (void) signBytes:(const void*)bytes length:(size_t)length intoDigest:(unsigned char*)digest;
+
+
+/** Sign a block of data
+
+ @param data The message
+ @return The digest, digestLength bytes long
+ */
+- (NSData*) signData:(NSData*)data;
+
+
+/** Sign a string, encoded as UTF-8
+
+ Short strings are encoded on the stack rather than through an intermediate NSData.
+ @param string The message
+ @return The digest, digestLength bytes long
+ */
+- (NSData*) signString:(NSString*)string;
+
+
+/** Sign a string, encoded as UTF-8, and return the digest as lowercase hex
+
+ @param string The message
+ @return The digest as a hex string
+ */
+- (NSString*) hexSignatureForString:(NSString*)string;
+
+@end
@@ -0,0 +1,109 @@
+//
+//  HMACContext.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "HMACContext.h"
+
+#import <CommonCrypto/CommonHMAC.h>
+
+// strings up to this many UTF-8 bytes are signed from a stack buffer
+#define HMAC_STACK_BUFFER 512
+
+@implementation HMACContext {
+    CCHmacContext _prepared;
+}
+
++ (HMACContext*) contextWithKey:(NSData*)key andAlgorithm:(HMACAlgorithm)algorithm {
+    return [[HMACContext alloc] initWithKeyBytes:key.bytes length:key.length andAlgorithm:algorithm];
+}
+
++ (HMACContext*) contextWithKeyString:(NSString*)key andAlgorithm:(HMACAlgorithm)algorithm {
+    return [HMACContext contextWithKey:[key dataUsingEncoding:NSUTF8StringEncoding] andAlgorithm:algorithm];
+}
+
+- (id) initWithKeyBytes:(const void*)key length:(size_t)length andAlgorithm:(HMACAlgorithm)algorithm {
+    self = [super init];
+    if(self) {
+        _algorithm = algorithm;
+
+        CCHmacAlgorithm cc = kCCHmacAlgSHA1;
+        _digestLength = CC_SHA1_DIGEST_LENGTH;
+        if(algorithm == HMACAlgorithmSHA256) {
+            cc = kCCHmacAlgSHA256;
+            _digestLength = CC_SHA256_DIGEST_LENGTH;
+        }
+
+        // hashes the padded key into the inner and outer states; every
+        // signature then starts from a copy of this context
+        CCHmacInit(&_prepared, cc, key, length);
+    }
+    return self;
+}
+
+#pragma mark - signing
+
+- (void) signBytes:(const void*)bytes length:(size_t)length intoDigest:(unsigned char*)digest {
+    CCHmacContext ctx = _prepared;
+    CCHmacUpdate(&ctx, bytes, length);
+    CCHmacFinal(&ctx, digest);
+}
+
+- (NSData*) signData:(NSData*)data {
+    NSMutableData *digest = [NSMutableData dataWithLength:_digestLength];
+    [self signBytes:data.bytes length:data.length intoDigest:digest.mutableBytes];
+    return digest;
+}
+
+- (void) signString:(NSString*)string intoDigest:(unsigned char*)digest {
+
+    // every path takes its length from the string, never from a NUL, so a
+    // string with embedded NULs signs the same whichever path it takes
+    CFStringRef cf = (__bridge CFStringRef)string;
+    CFIndex length = CFStringGetLength(cf);
+
+    // ASCII backed strings expose their bytes directly, one per character
+    const char *direct = CFStringGetCStringPtr(cf, kCFStringEncodingASCII);
+    if(direct != NULL) {
+        [self signBytes:direct length:length intoDigest:digest];
+        return;
+    }
+
+    UInt8 buffer[HMAC_STACK_BUFFER];
+    CFIndex used = 0;
+    CFIndex converted = CFStringGetBytes(cf, CFRangeMake(0, length), kCFStringEncodingUTF8, 0, false, buffer, sizeof(buffer), &used);
+
+    if(converted == length) {
+        [self signBytes:buffer length:used intoDigest:digest];
+    } else {
+        NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+        [self signBytes:data.bytes length:data.length intoDigest:digest];
+    }
+}
+
+- (NSData*) signString:(NSString*)string {
+    NSMutableData *digest = [NSMutableData dataWithLength:_digestLength];
+    [self signString:string intoDigest:digest.mutableBytes];
+    return digest;
+}
+
+- (NSString*) hexSignatureForString:(NSString*)string {
+
+    static const char hex[] = "0123456789abcdef";
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    char out[CC_SHA256_DIGEST_LENGTH * 2];
+
+    [self signString:string intoDigest:digest];
+    for(size_t i = 0; i < _digestLength; i++) {
+        out[i * 2] = hex[digest[i] >> 4];
+        out[i * 2 + 1] = hex[digest[i] & 0x0f];
+    }
+
+    return [[NSString alloc] initWithBytes:out length:_digestLength * 2 encoding:NSASCIIStringEncoding];
+}
+
+@end
@@ -0,0 +1,81 @@
+//
+//  HandleRegistry.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiBucket, KiiGroup, KiiUser;
+
+/** Interns bucket and group handles so that hot paths stop rebuilding them
+
+ Kii bucketWithName:, KiiUser bucketWithName:, KiiGroup bucketWithName: and Kii groupWithName: build a new object, with its own KiiACL, on every call. The registry returns the same object for the same scope and name for as long as anything else holds it. Entries are weak, so a handle nobody uses is released as usual, and the keys of released handles are swept out as the registry grows.
+
+ Interned handles are shared, mutable objects. Anything changed on one and not yet saved, such as entries put into a bucket's bucketACL or a group's members, is seen by every other caller that holds the same handle, and is saved by whichever of them saves first. Make such changes on an object from Kii bucketWithName: or Kii groupWithName: instead, and use the registry for reads and queries.
+
+ Each handle can carry a dictionary of attachments, such as per-bucket caches or statistics, which lives exactly as long as the handle.
+ */
+@interface HandleRegistry : NSObject
+
+/** The number of lookups answered with an existing handle */
+@property (readonly) NSUInteger hits;
+
+/** The number of lookups that had to create a handle */
+@property (readonly) NSUInteger misses;
+
+/** The shared handle registry
+
+ @return The process-wide HandleRegistry instance
+ */
++ (HandleRegistry*) sharedRegistry;
+
+
+/** Get the application-scope bucket with a name
+
+ The bucket is shared with every other caller, so do not leave unsaved ACL changes on it.
+ @param name The name of the bucket
+ @return The interned KiiBucket
+ */
+- (KiiBucket*) bucketWithName:(NSString*)name;
+
+
+/** Get a user-scope bucket
+
+ Users without an objectURI are not interned, and get a new bucket each time. The bucket is shared with every other caller, so do not leave unsaved ACL changes on it.
+ @param name The name of the bucket
+ @param user The user that owns the bucket
+ @return The interned KiiBucket
+ */
+- (KiiBucket*) bucketWithName:(NSString*)name forUser:(KiiUser*)user;
+
+
+/** Get a group-scope bucket
+
+ Groups without an objectURI are not interned, and get a new bucket each time. The bucket is shared with every other caller, so do not leave unsaved ACL changes on it.
+ @param name The name of the bucket
+ @param group The group that owns the bucket
+ @return The interned KiiBucket
+ */
+- (KiiBucket*) bucketWithName:(NSString*)name forGroup:(KiiGroup*)group;
+
+
+/** Get the group handle for a name
+
+ Kii groupWithName: describes a group to be created, so two calls with the same name normally mean two groups. Only use this where one name always refers to one group; use Kii groupWithName: to create distinct groups that share a name.
+ @param name The name of the group
+ @return The interned KiiGroup
+ */
+- (KiiGroup*) groupWithName:(NSString*)name;
+
+
+/** Get the attachments of a handle
+
+ @param handle A handle returned by the registry
+ @return A mutable dictionary released together with the handle
+ */
+- (NSMutableDictionary*) attachmentsForHandle:(id)handle;
+
+@end
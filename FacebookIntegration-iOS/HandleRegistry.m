@@ -0,0 +1,142 @@
+//
+//  HandleRegistry.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "HandleRegistry.h"
+
+#import <KiiSDK/Kii.h>
+#import <objc/runtime.h>
+
+// the fewest entries at which the map is swept for released handles
+#define HANDLE_PURGE_MINIMUM 64
+
+static char kAttachmentsKey;
+
+@interface HandleRegistry ()
+
+@property (nonatomic, strong) NSMapTable *handles;
+@property (nonatomic, assign) NSUInteger purgeAt;
+@property (assign) NSUInteger hits;
+@property (assign) NSUInteger misses;
+
+@end
+
+@implementation HandleRegistry
+
++ (HandleRegistry*) sharedRegistry {
+    static HandleRegistry *sharedRegistry = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedRegistry = [[HandleRegistry alloc] init];
+    });
+    return sharedRegistry;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _handles = [NSMapTable strongToWeakObjectsMapTable];
+        _purgeAt = HANDLE_PURGE_MINIMUM;
+    }
+    return self;
+}
+
+#pragma mark - interning
+
+// A strong-to-weak map table does not drop the key when its handle is
+// released, so the keys of dead handles are swept out whenever the map has
+// doubled since the last sweep. Called with _handles locked.
+- (void) purgeReleasedHandles {
+
+    if(_handles.count < _purgeAt) {
+        return;
+    }
+
+    for(NSString *key in [[_handles keyEnumerator] allObjects]) {
+        if([_handles objectForKey:key] == nil) {
+            [_handles removeObjectForKey:key];
+        }
+    }
+
+    _purgeAt = MAX(HANDLE_PURGE_MINIMUM, _handles.count * 2);
+}
+
+- (id) handleForKey:(NSString*)key orCreate:(id (^)(void))create {
+
+    @synchronized(_handles) {
+
+        id handle = [_handles objectForKey:key];
+        if(handle != nil) {
+            _hits++;
+            return handle;
+        }
+
+        [self purgeReleasedHandles];
+
+        handle = create();
+        if(handle != nil) {
+            [_handles setObject:handle forKey:key];
+        }
+        _misses++;
+
+        return handle;
+    }
+}
+
+- (KiiBucket*) bucketWithName:(NSString*)name {
+    return [self handleForKey:[@"bucket|app|" stringByAppendingString:name] orCreate:^id{
+        return [Kii bucketWithName:name];
+    }];
+}
+
+- (KiiBucket*) bucketWithName:(NSString*)name forUser:(KiiUser*)user {
+
+    if(user.objectURI == nil) {
+        return [user bucketWithName:name];
+    }
+
+    NSString *key = [NSString stringWithFormat:@"bucket|%@|%@", user.objectURI, name];
+    return [self handleForKey:key orCreate:^id{
+        return [user bucketWithName:name];
+    }];
+}
+
+- (KiiBucket*) bucketWithName:(NSString*)name forGroup:(KiiGroup*)group {
+
+    if(group.objectURI == nil) {
+        return [group bucketWithName:name];
+    }
+
+    NSString *key = [NSString stringWithFormat:@"bucket|%@|%@", group.objectURI, name];
+    return [self handleForKey:key orCreate:^id{
+        return [group bucketWithName:name];
+    }];
+}
+
+- (KiiGroup*) groupWithName:(NSString*)name {
+    return [self handleForKey:[@"group|app|" stringByAppendingString:name] orCreate:^id{
+        return [Kii groupWithName:name];
+    }];
+}
+
+#pragma mark - attachments
+
+- (NSMutableDictionary*) attachmentsForHandle:(id)handle {
+
+    @synchronized(handle) {
+
+        NSMutableDictionary *attachments = objc_getAssociatedObject(handle, &kAttachmentsKey);
+        if(attachments == nil) {
+            attachments = [NSMutableDictionary dictionary];
+            objc_setAssociatedObject(handle, &kAttachmentsKey, attachments, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+
+        return attachments;
+    }
+}
+
+@end
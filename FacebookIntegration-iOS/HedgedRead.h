@@ -0,0 +1,92 @@
+//
+//  HedgedRead.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiObject, KiiBucket, KiiQuery;
+
+/** A blocking, idempotent read. Must build its own SDK objects, as two copies may run at once */
+typedef id (^HedgedOperation)(NSError **error);
+
+/** Builds a new KiiBucket for each copy of a hedged query */
+typedef KiiBucket* (^HedgedBucketProvider)(void);
+
+/** Builds a new KiiQuery for each copy of a hedged query */
+typedef KiiQuery* (^HedgedQueryProvider)(void);
+
+/** Cuts tail latency on idempotent reads by sending a second copy of slow requests
+
+ Latency is tracked per operation type. Once a type has minSamples, a read of that type that has not answered by the observed percentile latency is sent again, and whichever copy succeeds first is returned. An error is only returned once every copy that was started has failed. Hedges are paid for from a budget that each read refills by maxHedgeRatio, so at most that fraction of extra load is added.
+
+ The SDK's synchronous calls cannot be cancelled, so the slower copy runs to completion in the background and its answer is dropped.
+ */
+@interface HedgedRead : NSObject
+
+/** Whether slow reads are hedged. Latency is tracked either way. Defaults to FALSE */
+@property (nonatomic, assign) BOOL enabled;
+
+/** The latency percentile after which a read is hedged. Defaults to 0.95 */
+@property (nonatomic, assign) double percentile;
+
+/** The number of samples a type needs before its reads are hedged. Defaults to 20 */
+@property (nonatomic, assign) NSUInteger minSamples;
+
+/** The largest fraction of extra reads hedging may add. Defaults to 0.05 */
+@property (nonatomic, assign) double maxHedgeRatio;
+
+/** The shared hedger
+
+ @return The process-wide HedgedRead instance
+ */
++ (HedgedRead*) sharedHedger;
+
+
+/** Run a read, hedging it if it is slow
+
+ This is a blocking method.
+ @param operation The read to run
+ @param type The operation type whose latency this read shares, such as "object.refresh"
+ @param error An NSError object, set to nil, to test for errors
+ @return The result of the first copy to answer, nil if it failed
+ */
+- (id) performSynchronous:(HedgedOperation)operation forType:(NSString*)type withError:(NSError**)error;
+
+
+/** Refresh an object, hedging slow requests
+
+ This is a blocking method.
+ @param uri The objectURI of the object
+ @param error An NSError object, set to nil, to test for errors
+ @return A refreshed KiiObject, nil on failure
+ */
+- (KiiObject*) refreshObjectWithURI:(NSString*)uri andError:(NSError**)error;
+
+
+/** Run a bucket query, hedging slow requests
+
+ SDK objects are not safe to share between two copies running at once, so each copy builds its own bucket and query from the providers.
+ Latency is tracked under "bucket.query", shared by every bucket.
+ This is a blocking method.
+ @param queryProvider Returns a new query to run. Called once per copy, on a background thread
+ @param bucketProvider Returns a new instance of the bucket to query. Called once per copy, on a background thread
+ @param error An NSError object, set to nil, to test for errors
+ @param nextQuery Set to the query for the next page, nil if there are no more results
+ @return An array of results, nil on failure
+ */
+- (NSArray*) executeQueryWithProvider:(HedgedQueryProvider)queryProvider onBucketWithProvider:(HedgedBucketProvider)bucketProvider withError:(NSError**)error andNext:(KiiQuery**)nextQuery;
+
+
+/** Statistics for an operation type
+
+ Keys are "reads", "hedges", "hedgeWins" (hedges that answered first), "hedgesDenied" (skipped for lack of budget), "p50" and "p95" (seconds, over the recent successful first copies).
+ @param type The operation type
+ @return A snapshot of the statistics, nil if the type has not been seen
+ */
+- (NSDictionary*) statsForType:(NSString*)type;
+
+@end
@@ -0,0 +1,295 @@
+//
+//  HedgedRead.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "HedgedRead.h"
+
+#import <KiiSDK/Kii.h>
+
+// recent latencies kept per operation type
+#define HEDGE_SAMPLES 200
+
+// the most hedges the budget can hold
+#define HEDGE_BUDGET_CAPACITY 5.0
+
+static int compareLatency(const void *a, const void *b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/** Latency samples and counters for one operation type */
+@interface HedgeStats : NSObject {
+@public
+    double samples[HEDGE_SAMPLES];
+}
+
+@property (nonatomic, assign) NSUInteger sampleCount;
+@property (nonatomic, assign) NSUInteger nextSample;
+@property (nonatomic, assign) NSUInteger reads;
+@property (nonatomic, assign) NSUInteger hedges;
+@property (nonatomic, assign) NSUInteger hedgeWins;
+@property (nonatomic, assign) NSUInteger hedgesDenied;
+
+- (void) addSample:(NSTimeInterval)latency;
+- (NSTimeInterval) latencyAtPercentile:(double)percentile;
+
+@end
+
+@implementation HedgeStats
+
+- (void) addSample:(NSTimeInterval)latency {
+    samples[_nextSample] = latency;
+    _nextSample = (_nextSample + 1) % HEDGE_SAMPLES;
+    _sampleCount = MIN(_sampleCount + 1, HEDGE_SAMPLES);
+}
+
+- (NSTimeInterval) latencyAtPercentile:(double)percentile {
+
+    if(_sampleCount == 0) {
+        return 0;
+    }
+
+    double sorted[HEDGE_SAMPLES];
+    memcpy(sorted, samples, _sampleCount * sizeof(double));
+    qsort(sorted, _sampleCount, sizeof(double), compareLatency);
+
+    NSUInteger index = MIN((NSUInteger)(percentile * _sampleCount), _sampleCount - 1);
+    return sorted[index];
+}
+
+@end
+
+
+/** The shared state of one read and its hedge */
+@interface HedgedCall : NSObject
+
+@property (nonatomic, strong) dispatch_semaphore_t done;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) NSUInteger started;
+@property (nonatomic, assign) NSUInteger failed;
+@property (nonatomic, assign) BOOL hedgeWon;
+@property (nonatomic, strong) id result;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation HedgedCall
+@end
+
+
+@interface HedgedRead ()
+
+@property (nonatomic, strong) NSMutableDictionary *stats;
+@property (nonatomic, assign) double budget;
+
+@end
+
+@implementation HedgedRead
+
++ (HedgedRead*) sharedHedger {
+    static HedgedRead *sharedHedger = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedHedger = [[HedgedRead alloc] init];
+    });
+    return sharedHedger;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _percentile = 0.95;
+        _minSamples = 20;
+        _maxHedgeRatio = 0.05;
+        _budget = HEDGE_BUDGET_CAPACITY;
+        _stats = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (HedgeStats*) statsFor:(NSString*)type {
+
+    // called with self locked
+    HedgeStats *stats = [_stats objectForKey:type];
+    if(stats == nil) {
+        stats = [[HedgeStats alloc] init];
+        [_stats setObject:stats forKey:type];
+    }
+    return stats;
+}
+
+#pragma mark - running
+
+// Returns TRUE if this copy succeeded, whether or not it answered first
+- (BOOL) runCopy:(HedgedOperation)operation ofCall:(HedgedCall*)call asHedge:(BOOL)hedge {
+
+    NSError *error = nil;
+    id result = operation(&error);
+
+    @synchronized(call) {
+
+        if(call.finished) {
+            return (error == nil);
+        }
+
+        // a failed copy only answers for the call once no other copy can
+        // still succeed
+        if(error != nil) {
+            call.failed++;
+            if(call.failed < call.started) {
+                return FALSE;
+            }
+        }
+
+        // only a successful hedge won; one that closed the call by failing last did not
+        call.finished = TRUE;
+        call.hedgeWon = hedge && error == nil;
+        call.result = result;
+        call.error = error;
+        dispatch_semaphore_signal(call.done);
+    }
+
+    return (error == nil);
+}
+
+- (id) performSynchronous:(HedgedOperation)operation forType:(NSString*)type withError:(NSError**)error {
+
+    NSTimeInterval hedgeAfter = 0;
+
+    @synchronized(self) {
+        HedgeStats *stats = [self statsFor:type];
+        stats.reads++;
+        _budget = MIN(HEDGE_BUDGET_CAPACITY, _budget + _maxHedgeRatio);
+        if(_enabled && stats.sampleCount >= _minSamples) {
+            hedgeAfter = [stats latencyAtPercentile:_percentile];
+        }
+    }
+
+    HedgedCall *call = [[HedgedCall alloc] init];
+    call.done = dispatch_semaphore_create(0);
+    call.started = 1;
+
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    NSTimeInterval started = [NSDate timeIntervalSinceReferenceDate];
+
+    dispatch_async(queue, ^{
+        BOOL succeeded = [self runCopy:operation ofCall:call asHedge:FALSE];
+
+        // the primary's own latency is the distribution being hedged against,
+        // so it is recorded whether or not it won. Failures are left out, as
+        // fast errors would pull the hedging threshold down
+        if(succeeded) {
+            @synchronized(self) {
+                [[self statsFor:type] addSample:[NSDate timeIntervalSinceReferenceDate] - started];
+            }
+        }
+    });
+
+    BOOL answered = TRUE;
+    if(hedgeAfter > 0) {
+        answered = (dispatch_semaphore_wait(call.done, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(hedgeAfter * NSEC_PER_SEC))) == 0);
+    } else {
+        dispatch_semaphore_wait(call.done, DISPATCH_TIME_FOREVER);
+    }
+
+    if(!answered) {
+
+        // the hedge is counted as started under the call's lock, so a
+        // primary failing at the same moment waits for it
+        BOOL hedge = FALSE;
+        @synchronized(call) {
+            if(!call.finished) {
+                @synchronized(self) {
+                    HedgeStats *stats = [self statsFor:type];
+                    if(_budget >= 1) {
+                        _budget -= 1;
+                        stats.hedges++;
+                        hedge = TRUE;
+                    } else {
+                        stats.hedgesDenied++;
+                    }
+                }
+                if(hedge) {
+                    call.started++;
+                }
+            }
+        }
+
+        if(hedge) {
+            dispatch_async(queue, ^{
+                [self runCopy:operation ofCall:call asHedge:TRUE];
+            });
+        }
+
+        dispatch_semaphore_wait(call.done, DISPATCH_TIME_FOREVER);
+
+        if(call.hedgeWon) {
+            @synchronized(self) {
+                [self statsFor:type].hedgeWins++;
+            }
+        }
+    }
+
+    if(error != NULL) {
+        *error = call.error;
+    }
+
+    return (call.error == nil) ? call.result : nil;
+}
+
+#pragma mark - reads
+
+- (KiiObject*) refreshObjectWithURI:(NSString*)uri andError:(NSError**)error {
+    return [self performSynchronous:^id(NSError **copyError) {
+        KiiObject *object = [KiiObject objectWithURI:uri];
+        [object refreshSynchronous:copyError];
+        return object;
+    } forType:@"object.refresh" withError:error];
+}
+
+- (NSArray*) executeQueryWithProvider:(HedgedQueryProvider)queryProvider onBucketWithProvider:(HedgedBucketProvider)bucketProvider withError:(NSError**)error andNext:(KiiQuery**)nextQuery {
+
+    // results and the next query travel together, so both come from the winner
+    NSArray *answer = [self performSynchronous:^id(NSError **copyError) {
+        KiiBucket *bucket = bucketProvider();
+        KiiQuery *query = queryProvider();
+        KiiQuery *next = nil;
+        NSArray *results = [bucket executeQuerySynchronous:query withError:copyError andNext:&next];
+        return @[ (results != nil) ? results : [NSNull null], (next != nil) ? next : [NSNull null] ];
+    } forType:@"bucket.query" withError:error];
+
+    id results = [answer objectAtIndex:0];
+    id next = [answer objectAtIndex:1];
+
+    if(nextQuery != NULL) {
+        *nextQuery = (next != [NSNull null]) ? next : nil;
+    }
+
+    return (results != [NSNull null]) ? results : nil;
+}
+
+#pragma mark - statistics
+
+- (NSDictionary*) statsForType:(NSString*)type {
+    @synchronized(self) {
+
+        HedgeStats *stats = [_stats objectForKey:type];
+        if(stats == nil) {
+            return nil;
+        }
+
+        return @{ @"reads" : @(stats.reads),
+                  @"hedges" : @(stats.hedges),
+                  @"hedgeWins" : @(stats.hedgeWins),
+                  @"hedgesDenied" : @(stats.hedgesDenied),
+                  @"p50" : @([stats latencyAtPercentile:0.5]),
+                  @"p95" : @([stats latencyAtPercentile:0.95]) };
+    }
+}
+
+@end
@@ -0,0 +1,78 @@
+//
+//  KiiFileBucket+Batch.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <KiiSDK/Kii.h>
+
+typedef enum {
+    FileBatchActionMoveToTrash,
+    FileBatchActionRestoreFromTrash,
+    FileBatchActionShred
+} FileBatchAction;
+
+/** Called once per file as it is processed, with the error if the action failed. Calls are serialized, but made on a background thread */
+typedef void (^FileBatchProgress)(KiiFile *file, NSError *error);
+
+/** Called on the main thread once every file in a batch has been processed, with the KiiFiles the action succeeded and failed on. errors maps the objectURI of each failed file to its error. error is set if the batch stopped early because the query or a page failed */
+typedef void (^FileBatchCompletion)(NSArray *succeeded, NSArray *failed, NSDictionary *errors, NSError *error);
+
+/** Bulk trash, restore and shred operations
+
+ Each file still costs one request, but requests are pipelined with at most `concurrency` in flight. The outcome of each file is streamed through the progress block as it completes, and every outcome is delivered again in one completion. A failure on one file does not stop the rest of the batch.
+
+ Files found by a query or clause that the action does not apply to, such as trashed files for FileBatchActionMoveToTrash, are skipped by checking KiiFile trashed.
+ */
+@interface KiiFileBucket (Batch)
+
+/** Apply an action to an array of files
+
+ This is a non-blocking method.
+ @param action One of the FileBatchAction values
+ @param files An array of KiiFile objects that exist on the server
+ @param concurrency The maximum number of requests in flight. 0 uses a default of 4
+ @param progress The block called with the outcome of each file. May be nil
+ @param completion The block called on the main thread with the files that succeeded and failed
+ */
+- (void) performAction:(FileBatchAction)action
+               onFiles:(NSArray*)files
+       withConcurrency:(NSUInteger)concurrency
+              progress:(FileBatchProgress)progress
+         andCompletion:(FileBatchCompletion)completion;
+
+
+/** Apply an action to every file returned by a query
+
+ KiiFileBucket queries have no next query, so the query is run again after every full page until a page comes back short. Each file is processed once. This moves through all the matches when processed files drop out of the query, for example when it filters on the trashed state. If a full page holds only files already seen, the rest of the matches cannot be reached, and the completion gets a KiiErrorSingleQueryLimitExceeded error instead of reporting success; use the clause variant for such queries. The query's limit is set to 100 if it was not set or was higher. This is a non-blocking method.
+ @param action One of the FileBatchAction values
+ @param query The query selecting the files
+ @param concurrency The maximum number of requests in flight. 0 uses a default of 4
+ @param progress The block called with the outcome of each file. May be nil
+ @param completion The block called on the main thread with the files that succeeded and failed, and the query error if the query failed or stopped moving on
+ */
+- (void) performAction:(FileBatchAction)action
+  onFilesMatchingQuery:(KiiQuery*)query
+       withConcurrency:(NSUInteger)concurrency
+              progress:(FileBatchProgress)progress
+         andCompletion:(FileBatchCompletion)completion;
+
+
+/** Apply an action to every file matching a clause, page by page
+
+ Intended for very large buckets. Files are streamed through a FileBucketPager, so the action runs on one page while the next page is fetched. The pager does not filter on the trashed state on the server. This is a non-blocking method.
+ @param action One of the FileBatchAction values
+ @param clause The clause selecting the files. Pass nil for all files
+ @param concurrency The maximum number of requests in flight. 0 uses a default of 4
+ @param progress The block called with the outcome of each file. May be nil
+ @param completion The block called on the main thread with the files that succeeded and failed, and the paging error if a page failed to load
+ */
+- (void) performAction:(FileBatchAction)action
+ onFilesMatchingClause:(KiiClause*)clause
+       withConcurrency:(NSUInteger)concurrency
+              progress:(FileBatchProgress)progress
+         andCompletion:(FileBatchCompletion)completion;
+
+@end
@@ -0,0 +1,234 @@
+//
+//  KiiFileBucket+Batch.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "KiiFileBucket+Batch.h"
+
+#import "FileBucketPager.h"
+
+#import "NSError+KiiErrorCode.h"
+
+#define FILE_BATCH_DEFAULT_CONCURRENCY 4
+
+// KiiQuery limit must be in (0, 100]
+#define FILE_BATCH_QUERY_LIMIT 100
+
+/** Collects per-file outcomes from concurrent workers, and passes each one on */
+@interface FileBatchResults : NSObject
+
+@property (nonatomic, copy) FileBatchProgress progress;
+@property (nonatomic, strong) NSMutableArray *succeeded;
+@property (nonatomic, strong) NSMutableArray *failed;
+@property (nonatomic, strong) NSMutableDictionary *errors;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation FileBatchResults
+@end
+
+
+@implementation KiiFileBucket (Batch)
+
++ (void) applyAction:(FileBatchAction)action toFile:(KiiFile*)file withError:(NSError**)error {
+    switch(action) {
+        case FileBatchActionMoveToTrash:        [file moveToTrashSynchronous:error]; break;
+        case FileBatchActionRestoreFromTrash:   [file restoreFromTrashSynchronous:error]; break;
+        case FileBatchActionShred:              [file shredFileSynchronous:error]; break;
+    }
+}
+
+// Trashing a trashed file, or restoring or shredding one outside the trash,
+// would just fail, so files matched by a query or clause are checked first
++ (BOOL) action:(FileBatchAction)action appliesToFile:(KiiFile*)file {
+    return (action == FileBatchActionMoveToTrash) ? !file.trashed : file.trashed;
+}
+
+// Blocks until every file has been processed, with at most `concurrency`
+// requests in flight.
++ (void) applyAction:(FileBatchAction)action
+             toFiles:(NSArray*)files
+     withConcurrency:(NSUInteger)concurrency
+         intoResults:(FileBatchResults*)results {
+
+    dispatch_semaphore_t slots = dispatch_semaphore_create(concurrency);
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+    for(KiiFile *file in files) {
+
+        dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+
+        dispatch_group_async(group, queue, ^{
+
+            NSError *error = nil;
+            [KiiFileBucket applyAction:action toFile:file withError:&error];
+
+            @synchronized(results) {
+                if(error == nil) {
+                    [results.succeeded addObject:file];
+                } else {
+                    [results.failed addObject:file];
+                    if(file.objectURI != nil) {
+                        [results.errors setObject:error forKey:file.objectURI];
+                    }
+                }
+                if(results.progress != nil) {
+                    results.progress(file, error);
+                }
+            }
+
+            dispatch_semaphore_signal(slots);
+        });
+    }
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+}
+
++ (void) finishResults:(FileBatchResults*)results withCompletion:(FileBatchCompletion)completion {
+    if(completion != nil) {
+        NSArray *succeeded = results.succeeded;
+        NSArray *failed = results.failed;
+        NSDictionary *errors = results.errors;
+        NSError *error = results.error;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(succeeded, failed, errors, error);
+        });
+    }
+}
+
++ (FileBatchResults*) resultsWithProgress:(FileBatchProgress)progress {
+    FileBatchResults *results = [[FileBatchResults alloc] init];
+    results.progress = progress;
+    results.succeeded = [NSMutableArray array];
+    results.failed = [NSMutableArray array];
+    results.errors = [NSMutableDictionary dictionary];
+    return results;
+}
+
+#pragma mark - public
+
+- (void) performAction:(FileBatchAction)action
+               onFiles:(NSArray*)files
+       withConcurrency:(NSUInteger)concurrency
+              progress:(FileBatchProgress)progress
+         andCompletion:(FileBatchCompletion)completion {
+
+    NSUInteger slots = (concurrency > 0) ? concurrency : FILE_BATCH_DEFAULT_CONCURRENCY;
+    NSArray *batch = [files copy];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        FileBatchResults *results = [KiiFileBucket resultsWithProgress:progress];
+        [KiiFileBucket applyAction:action toFiles:batch withConcurrency:slots intoResults:results];
+        [KiiFileBucket finishResults:results withCompletion:completion];
+    });
+}
+
+- (void) performAction:(FileBatchAction)action
+  onFilesMatchingQuery:(KiiQuery*)query
+       withConcurrency:(NSUInteger)concurrency
+              progress:(FileBatchProgress)progress
+         andCompletion:(FileBatchCompletion)completion {
+
+    NSUInteger slots = (concurrency > 0) ? concurrency : FILE_BATCH_DEFAULT_CONCURRENCY;
+
+    // a full page is the only sign that more files match, so the page size
+    // must be known
+    if(query.limit <= 0 || query.limit > FILE_BATCH_QUERY_LIMIT) {
+        query.limit = FILE_BATCH_QUERY_LIMIT;
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        FileBatchResults *results = [KiiFileBucket resultsWithProgress:progress];
+        NSMutableSet *seen = [NSMutableSet set];
+
+        // KiiFileBucket queries have no next query, so the query is run again
+        // after each full page. Processed files drop out of a query that
+        // filters on the trashed state, which moves it on to the next page
+        while(TRUE) {
+
+            NSError *error = nil;
+            NSArray *page = [self executeQuerySynchronous:query withError:&error];
+
+            if(error != nil) {
+                results.error = error;
+                break;
+            }
+
+            NSUInteger unseen = 0;
+            NSMutableArray *fresh = [NSMutableArray array];
+            for(KiiFile *file in page) {
+                if(file.objectURI != nil && ![seen containsObject:file.objectURI]) {
+                    [seen addObject:file.objectURI];
+                    unseen++;
+                    if([KiiFileBucket action:action appliesToFile:file]) {
+                        [fresh addObject:file];
+                    }
+                }
+            }
+
+            [KiiFileBucket applyAction:action toFiles:fresh withConcurrency:slots intoResults:results];
+
+            if(page.count < (NSUInteger)query.limit) {
+                break;
+            }
+
+            // a full page of files already seen - the query does not move on,
+            // so the rest of the matches cannot be reached
+            if(unseen == 0) {
+                results.error = [NSError kiiErrorWithCode:KiiErrorSingleQueryLimitExceeded];
+                break;
+            }
+        }
+
+        [KiiFileBucket finishResults:results withCompletion:completion];
+    });
+}
+
+- (void) performAction:(FileBatchAction)action
+ onFilesMatchingClause:(KiiClause*)clause
+       withConcurrency:(NSUInteger)concurrency
+              progress:(FileBatchProgress)progress
+         andCompletion:(FileBatchCompletion)completion {
+
+    NSUInteger slots = (concurrency > 0) ? concurrency : FILE_BATCH_DEFAULT_CONCURRENCY;
+
+    // the trashed state is checked on each KiiFile rather than with a
+    // server-side filter, whose field name the SDK does not document
+    FileBucketPager *pager = [FileBucketPager pagerWithBucket:self andClause:clause];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        FileBatchResults *results = [KiiFileBucket resultsWithProgress:progress];
+
+        // the pager prefetches, so the next page loads while this one is processed
+        while(pager.hasMore) {
+
+            NSError *error = nil;
+            NSArray *page = [pager nextPageSynchronous:&error];
+
+            if(error != nil) {
+                results.error = error;
+                break;
+            }
+
+            NSMutableArray *applicable = [NSMutableArray arrayWithCapacity:page.count];
+            for(KiiFile *file in page) {
+                if([KiiFileBucket action:action appliesToFile:file]) {
+                    [applicable addObject:file];
+                }
+            }
+
+            [KiiFileBucket applyAction:action toFiles:applicable withConcurrency:slots intoResults:results];
+        }
+
+        [KiiFileBucket finishResults:results withCompletion:completion];
+    });
+}
+
+@end
@@ -0,0 +1,80 @@
+//
+//  LoginPrefetcher.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiUser;
+
+/** A unit of post-login work. Runs on a background thread and returns the value to store under its key. A task registered as retryable must be idempotent, as its transient failures are run again through RetryPolicy */
+typedef id (^LoginPrefetchTask)(KiiUser *user, NSError **error);
+
+/** Called on the main thread once every prefetch task has finished. Both dictionaries are keyed by task key */
+typedef void (^LoginPrefetchCompletion)(NSDictionary *results, NSDictionary *errors);
+
+/** Overlaps post-login work with the social login flow
+
+ prewarmConnections should be called just before KiiSocialConnect logIn:usingOptions:withDelegate:andCallback:. While the user is away at Facebook it resolves and opens a TLS connection to the Kii API host, which the SDK's requests then reuse. As soon as the login callback delivers the user, prefetchForUser:withCompletion: runs every registered task concurrently, so the first screen can be filled from results instead of a series of sequential calls.
+ */
+@interface LoginPrefetcher : NSObject
+
+/** The base URL of the Kii API to prewarm. Defaults to https://api.kii.com/api */
+@property (nonatomic, strong) NSString *apiURL;
+
+/** Results of the last prefetch, keyed by task key */
+@property (readonly) NSDictionary *results;
+
+/** The shared login prefetcher
+
+ @return The process-wide LoginPrefetcher instance
+ */
++ (LoginPrefetcher*) sharedPrefetcher;
+
+
+/** Open a connection to the Kii API host ahead of the first authenticated request
+
+ This is a non-blocking method.
+ */
+- (void) prewarmConnections;
+
+
+/** Register a task to run after login, once, without retrying
+
+ Tasks run concurrently, so a task must not change the KiiUser it is given.
+ @param task The work to run. Its return value is stored in results under key
+ @param key A unique name for the task. Registering the same key again replaces the task
+ */
+- (void) addTask:(LoginPrefetchTask)task forKey:(NSString*)key;
+
+
+/** Register a task to run after login
+
+ Tasks run concurrently, so a task must not change the KiiUser it is given.
+ @param task The work to run. Its return value is stored in results under key
+ @param key A unique name for the task. Registering the same key again replaces the task
+ @param retryable TRUE to run the task again through RetryPolicy when it fails for a transient reason. Only pass TRUE for an idempotent task, such as a read
+ */
+- (void) addTask:(LoginPrefetchTask)task forKey:(NSString*)key retryable:(BOOL)retryable;
+
+
+/** Register the common post-login tasks
+
+ Adds "user" (refreshSynchronous:), "groups" (memberOfGroupsSynchronous:, also fed to PermissionCache and MembershipIndex) and one "bucket:<name>" query per user-scope bucket name. "user" and "groups" share the KiiUser, which the refresh rewrites, so they run one after the other while the bucket queries run alongside. All of them are reads, so all are retryable. Call once, for example at launch; calling again replaces the same tasks.
+ @param bucketNames An array of bucket names to query in the user's scope. May be nil
+ */
+- (void) addDefaultTasksWithBuckets:(NSArray*)bucketNames;
+
+
+/** Run every registered task concurrently for a newly logged in user
+
+ This is a non-blocking method.
+ @param user The user that just logged in
+ @param completion The block called on the main thread when every task has finished. May be nil
+ */
+- (void) prefetchForUser:(KiiUser*)user withCompletion:(LoginPrefetchCompletion)completion;
+
+@end
@@ -0,0 +1,233 @@
+//
+//  LoginPrefetcher.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "LoginPrefetcher.h"
+
+#import <KiiSDK/Kii.h>
+
+#import "HandleRegistry.h"
+#import "MembershipIndex.h"
+#import "NSError+KiiErrorCode.h"
+#import "PermissionCache.h"
+#import "RetryPolicy.h"
+
+@interface LoginPrefetcher ()
+
+@property (nonatomic, strong) NSMutableDictionary *tasks;
+
+// keys of the tasks that share the KiiUser object, run one after another in
+// the order they were added
+@property (nonatomic, strong) NSMutableArray *userTaskKeys;
+@property (nonatomic, strong) NSMutableSet *retryableKeys;
+@property (strong) NSDictionary *results;
+
+@end
+
+// One prefetch: the tasks as they were registered when it started, and what
+// they have produced so far. Results are only touched on the main thread
+@interface PrefetchRun : NSObject
+
+@property (nonatomic, strong) KiiUser *user;
+@property (nonatomic, strong) NSDictionary *tasks;
+@property (nonatomic, strong) NSSet *retryableKeys;
+@property (nonatomic, strong) NSMutableDictionary *results;
+@property (nonatomic, strong) NSMutableDictionary *errors;
+@property (nonatomic, strong) dispatch_group_t group;
+
+- (void) runKeys:(NSArray*)keys fromIndex:(NSUInteger)index;
+
+@end
+
+@implementation PrefetchRun
+
+- (void) runKey:(NSString*)key withCompletion:(dispatch_block_t)completion {
+
+    LoginPrefetchTask task = [_tasks objectForKey:key];
+    KiiUser *user = _user;
+
+    RetryCompletion finished = ^(id result, NSError *error) {
+        if(error != nil) {
+            [_errors setObject:error forKey:key];
+        } else if(result != nil) {
+            [_results setObject:result forKey:key];
+        }
+        completion();
+    };
+
+    if([_retryableKeys containsObject:key]) {
+        [[RetryPolicy sharedPolicy] perform:^id(NSError **attemptError) {
+            return task(user, attemptError);
+        } withCompletion:finished];
+        return;
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+        NSError *error = nil;
+        id result = task(user, &error);
+        dispatch_async(dispatch_get_main_queue(), ^{
+            finished(result, error);
+        });
+    });
+}
+
+// Runs keys one after another, leaving the group after the last one
+- (void) runKeys:(NSArray*)keys fromIndex:(NSUInteger)index {
+
+    if(index >= keys.count) {
+        dispatch_group_leave(_group);
+        return;
+    }
+
+    [self runKey:[keys objectAtIndex:index] withCompletion:^{
+        [self runKeys:keys fromIndex:index + 1];
+    }];
+}
+
+@end
+
+@implementation LoginPrefetcher
+
++ (LoginPrefetcher*) sharedPrefetcher {
+    static LoginPrefetcher *sharedPrefetcher = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPrefetcher = [[LoginPrefetcher alloc] init];
+    });
+    return sharedPrefetcher;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _apiURL = @"https://api.kii.com/api";
+        _tasks = [NSMutableDictionary dictionary];
+        _userTaskKeys = [NSMutableArray array];
+        _retryableKeys = [NSMutableSet set];
+    }
+    return self;
+}
+
+#pragma mark - prewarming
+
+- (void) prewarmConnections {
+
+    // any response at all means DNS, TCP and TLS are done, and the
+    // connection is left in the shared URL loading pool for the SDK
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:_apiURL]
+                                                           cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                                                       timeoutInterval:10];
+    request.HTTPMethod = @"HEAD";
+
+    [NSURLConnection sendAsynchronousRequest:request
+                                       queue:[NSOperationQueue mainQueue]
+                           completionHandler:^(NSURLResponse *response, NSData *data, NSError *error) {
+                               // a 4xx still warmed the connection; only a
+                               // server failure is worth reporting
+                               if(error == nil && [response isKindOfClass:[NSHTTPURLResponse class]]) {
+                                   NSError *statusError = [NSError errorWithHTTPResponse:(NSHTTPURLResponse*)response];
+                                   if([statusError httpStatusCode] >= 500) {
+                                       error = statusError;
+                                   }
+                               }
+                               if(error != nil) {
+                                   NSLog(@"Prewarm of %@ failed: %@", _apiURL, error);
+                               }
+                           }];
+}
+
+#pragma mark - tasks
+
+- (void) addTask:(LoginPrefetchTask)task forKey:(NSString*)key {
+    [self addTask:task forKey:key retryable:FALSE];
+}
+
+- (void) addTask:(LoginPrefetchTask)task forKey:(NSString*)key retryable:(BOOL)retryable {
+    @synchronized(_tasks) {
+        [_tasks setObject:[task copy] forKey:key];
+        [_userTaskKeys removeObject:key];
+        if(retryable) {
+            [_retryableKeys addObject:key];
+        } else {
+            [_retryableKeys removeObject:key];
+        }
+    }
+}
+
+// A task that reads or changes the KiiUser itself. refreshSynchronous:
+// rewrites the user's fields, so these never run at the same time
+- (void) addUserTask:(LoginPrefetchTask)task forKey:(NSString*)key retryable:(BOOL)retryable {
+    @synchronized(_tasks) {
+        [self addTask:task forKey:key retryable:retryable];
+        [_userTaskKeys addObject:key];
+    }
+}
+
+- (void) addDefaultTasksWithBuckets:(NSArray*)bucketNames {
+
+    [self addUserTask:^id(KiiUser *user, NSError **error) {
+        [user refreshSynchronous:error];
+        return user;
+    } forKey:@"user" retryable:TRUE];
+
+    [self addUserTask:^id(KiiUser *user, NSError **error) {
+        NSArray *groups = [user memberOfGroupsSynchronous:error];
+        if(groups != nil) {
+            [[PermissionCache sharedCache] setMemberships:groups];
+            [[MembershipIndex sharedIndex] setGroups:groups ofUser:user];
+        }
+        return groups;
+    } forKey:@"groups" retryable:TRUE];
+
+    for(NSString *name in bucketNames) {
+        [self addTask:^id(KiiUser *user, NSError **error) {
+            KiiQuery *query = [KiiQuery queryWithClause:nil];
+            KiiBucket *bucket = [[HandleRegistry sharedRegistry] bucketWithName:name forUser:user];
+            KiiQuery *next = nil;
+            return [bucket executeQuerySynchronous:query withError:error andNext:&next];
+        } forKey:[@"bucket:" stringByAppendingString:name] retryable:TRUE];
+    }
+}
+
+- (void) prefetchForUser:(KiiUser*)user withCompletion:(LoginPrefetchCompletion)completion {
+
+    PrefetchRun *run = [[PrefetchRun alloc] init];
+    NSArray *userTaskKeys = nil;
+    @synchronized(_tasks) {
+        run.tasks = [_tasks copy];
+        run.retryableKeys = [_retryableKeys copy];
+        userTaskKeys = [_userTaskKeys copy];
+    }
+
+    run.user = user;
+    run.results = [NSMutableDictionary dictionary];
+    run.errors = [NSMutableDictionary dictionary];
+    run.group = dispatch_group_create();
+
+    // the tasks sharing the KiiUser run in sequence, alongside the rest. No
+    // thread waits on a task; each one calls back when it is done
+    if(userTaskKeys.count > 0) {
+        dispatch_group_enter(run.group);
+        [run runKeys:userTaskKeys fromIndex:0];
+    }
+
+    for(NSString *key in run.tasks) {
+        if(![userTaskKeys containsObject:key]) {
+            dispatch_group_enter(run.group);
+            [run runKeys:@[key] fromIndex:0];
+        }
+    }
+
+    dispatch_group_notify(run.group, dispatch_get_main_queue(), ^{
+        self.results = run.results;
+        if(completion != nil) {
+            completion(run.results, run.errors);
+        }
+    });
+}
+
+@end
@@ -0,0 +1,104 @@
+//
+//  LoginTrace.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class LoginTrace;
+
+/** One timed phase of a login, with times in seconds from the start of the trace */
+@interface LoginTraceSpan : NSObject
+
+/** The name of the phase */
+@property (nonatomic, readonly) NSString *name;
+
+/** When the phase began */
+@property (nonatomic, readonly) NSTimeInterval start;
+
+/** When the phase ended */
+@property (nonatomic, readonly) NSTimeInterval end;
+
+/** end - start */
+@property (nonatomic, readonly) NSTimeInterval duration;
+
+@end
+
+
+/** Receives finished login traces */
+@protocol LoginTraceSink <NSObject>
+
+/** Called on the main thread when a trace finishes
+
+ @param trace The trace that finished
+ @param spans Its LoginTraceSpan objects, in the order they began
+ @param error The login error, nil if the login succeeded
+ */
+- (void) loginTrace:(LoginTrace*)trace didFinishWithSpans:(NSArray*)spans andError:(NSError*)error;
+
+@end
+
+
+/** A sink that logs each trace as a table of phases */
+@interface LoginTraceLogSink : NSObject <LoginTraceSink>
+@end
+
+
+/** Times each phase of a social login
+
+ A trace is begun in front of KiiSocialConnect logIn:usingOptions:withDelegate:andCallback: and finished in the login callback. Spans mark the phases in between: the network setup, the trip out to Facebook until handleOpenURL: brings the user back, and the token exchange until the callback. A "total" span covers the whole login. Finished traces go to every registered sink.
+ */
+@interface LoginTrace : NSObject
+
+/** TRUE between begin and finishWithError: */
+@property (readonly) BOOL active;
+
+/** The shared login trace
+
+ @return The process-wide LoginTrace instance
+ */
++ (LoginTrace*) sharedTrace;
+
+
+/** Register a sink for finished traces
+
+ @param sink The sink to add. Held strongly until removed
+ */
+- (void) addSink:(id<LoginTraceSink>)sink;
+
+
+/** Unregister a sink
+
+ @param sink The sink to remove
+ */
+- (void) removeSink:(id<LoginTraceSink>)sink;
+
+
+/** Start a new trace, discarding any unfinished one */
+- (void) begin;
+
+
+/** Start a named phase. Ignored when no trace is active
+
+ @param name The name of the phase
+ */
+- (void) beginSpan:(NSString*)name;
+
+
+/** End a named phase. Ignored if the phase is not open
+
+ @param name The name of the phase
+ */
+- (void) endSpan:(NSString*)name;
+
+
+/** End every open phase, finish the trace and deliver it to the sinks
+
+ @param error The login error, nil if the login succeeded
+ */
+- (void) finishWithError:(NSError*)error;
+
+@end
@@ -0,0 +1,159 @@
+//
+//  LoginTrace.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "LoginTrace.h"
+
+@interface LoginTraceSpan ()
+
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, assign) NSTimeInterval start;
+@property (nonatomic, assign) NSTimeInterval end;
+@property (nonatomic, assign) BOOL open;
+
+@end
+
+@implementation LoginTraceSpan
+
+- (NSTimeInterval) duration {
+    return _end - _start;
+}
+
+@end
+
+
+@implementation LoginTraceLogSink
+
+- (void) loginTrace:(LoginTrace*)trace didFinishWithSpans:(NSArray*)spans andError:(NSError*)error {
+
+    NSMutableString *breakdown = [NSMutableString string];
+    for(LoginTraceSpan *span in spans) {
+        [breakdown appendFormat:@"\n  %-16s %8.3fs  (+%.3fs)", [span.name UTF8String], span.duration, span.start];
+    }
+
+    NSLog(@"Login trace%@%@", (error != nil) ? [NSString stringWithFormat:@" failed: %@", error] : @"", breakdown);
+}
+
+@end
+
+
+@interface LoginTrace ()
+
+@property (nonatomic, strong) NSMutableArray *sinks;
+@property (nonatomic, strong) NSMutableArray *spans;
+@property (nonatomic, assign) NSTimeInterval started;
+@property (assign) BOOL active;
+
+@end
+
+@implementation LoginTrace
+
++ (LoginTrace*) sharedTrace {
+    static LoginTrace *sharedTrace = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedTrace = [[LoginTrace alloc] init];
+    });
+    return sharedTrace;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _sinks = [NSMutableArray array];
+        _spans = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void) addSink:(id<LoginTraceSink>)sink {
+    @synchronized(self) {
+        [_sinks addObject:sink];
+    }
+}
+
+- (void) removeSink:(id<LoginTraceSink>)sink {
+    @synchronized(self) {
+        [_sinks removeObject:sink];
+    }
+}
+
+#pragma mark - spans
+
+- (NSTimeInterval) now {
+    return [NSDate timeIntervalSinceReferenceDate] - _started;
+}
+
+- (void) begin {
+    @synchronized(self) {
+        [_spans removeAllObjects];
+        _started = [NSDate timeIntervalSinceReferenceDate];
+        self.active = TRUE;
+    }
+    [self beginSpan:@"total"];
+}
+
+- (void) beginSpan:(NSString*)name {
+    @synchronized(self) {
+
+        if(!self.active) {
+            return;
+        }
+
+        LoginTraceSpan *span = [[LoginTraceSpan alloc] init];
+        span.name = name;
+        span.start = [self now];
+        span.open = TRUE;
+        [_spans addObject:span];
+    }
+}
+
+- (void) endSpan:(NSString*)name {
+    @synchronized(self) {
+        for(LoginTraceSpan *span in _spans) {
+            if(span.open && [span.name isEqualToString:name]) {
+                span.end = [self now];
+                span.open = FALSE;
+                return;
+            }
+        }
+    }
+}
+
+- (void) finishWithError:(NSError*)error {
+
+    NSArray *spans = nil;
+    NSArray *sinks = nil;
+
+    @synchronized(self) {
+
+        if(!self.active) {
+            return;
+        }
+
+        NSTimeInterval now = [self now];
+        for(LoginTraceSpan *span in _spans) {
+            if(span.open) {
+                span.end = now;
+                span.open = FALSE;
+            }
+        }
+
+        spans = [_spans copy];
+        sinks = [_sinks copy];
+        [_spans removeAllObjects];
+        self.active = FALSE;
+    }
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+        for(id<LoginTraceSink> sink in sinks) {
+            [sink loginTrace:self didFinishWithSpans:spans andError:error];
+        }
+    });
+}
+
+@end
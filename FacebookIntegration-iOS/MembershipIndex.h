@@ -0,0 +1,101 @@
+//
+//  MembershipIndex.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiUser, KiiGroup;
+
+typedef enum {
+    MembershipUnknown,
+    MembershipMember,
+    MembershipNotMember
+} MembershipState;
+
+/** A local index of which users belong to which groups
+
+ The index is filled from memberOfGroupsSynchronous: (every group of one user) and getMemberListSynchronous: (every member of one group), and kept current by GroupMembershipBatcher saves and deleteGroupSynchronous:withError:. Lookups are a single set membership test and never touch the network. A lookup whose user or group was last loaded more than revalidationInterval ago still answers from the index, and reloads that user, or group, in the background.
+
+ The index belongs to the current user. It is saved to Application Support in a file named after that user, so it is warm the next time they are logged in, and is swapped out whenever [KiiUser currentUser] changes. Nothing is answered while no user is logged in.
+ */
+@interface MembershipIndex : NSObject
+
+/** How long a loaded user or group is trusted before lookups revalidate it, in seconds. Defaults to 5 minutes */
+@property (nonatomic, assign) NSTimeInterval revalidationInterval;
+
+/** The shared membership index
+
+ @return The process-wide MembershipIndex instance
+ */
++ (MembershipIndex*) sharedIndex;
+
+
+/** Check whether a user belongs to a group
+
+ MembershipUnknown is returned when neither the user's groups nor the group's members have been loaded.
+ @param userURI The objectURI of the user
+ @param groupURI The objectURI of the group
+ @return The membership state
+ */
+- (MembershipState) stateOfUser:(NSString*)userURI inGroup:(NSString*)groupURI;
+
+
+/** Load every group of a user into the index
+
+ This is a blocking method.
+ @param user The user to load
+ @param error An NSError object, set to nil, to test for errors
+ @return The groups the user belongs to, nil on failure
+ */
+- (NSArray*) loadGroupsOfUser:(KiiUser*)user withError:(NSError**)error;
+
+
+/** Record the complete list of groups a user belongs to
+
+ @param groups An array of KiiGroup objects, as returned by memberOfGroupsSynchronous:
+ @param user The user they belong to
+ */
+- (void) setGroups:(NSArray*)groups ofUser:(KiiUser*)user;
+
+
+/** Record the complete member list of a group
+
+ @param members An array of KiiUser objects, as returned by getMemberListSynchronous:
+ @param group The group they belong to
+ */
+- (void) setMembers:(NSArray*)members ofGroup:(KiiGroup*)group;
+
+
+/** Record users that were added to a group
+
+ @param users An array of KiiUser objects
+ @param groupURI The objectURI of the group
+ */
+- (void) addUsers:(NSArray*)users toGroup:(NSString*)groupURI;
+
+
+/** Record users that were removed from a group
+
+ @param users An array of KiiUser objects
+ @param groupURI The objectURI of the group
+ */
+- (void) removeUsers:(NSArray*)users fromGroup:(NSString*)groupURI;
+
+
+/** Delete a group and drop it from the index
+
+ This is a blocking method.
+ @param group The group to delete
+ @param error An NSError object, set to nil, to test for errors
+ */
+- (void) deleteGroupSynchronous:(KiiGroup*)group withError:(NSError**)error;
+
+
+/** Drop everything from the current user's index and delete its file. Called by SessionStore clearSession */
+- (void) removeAll;
+
+@end
@@ -0,0 +1,362 @@
+//
+//  MembershipIndex.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "MembershipIndex.h"
+
+#import <KiiSDK/Kii.h>
+
+// how long mutations are collected before the index is written to disk
+#define MEMBERSHIP_SAVE_DELAY 2.0
+
+@interface MembershipIndex ()
+
+// "userURI|groupURI" for every known membership
+@property (nonatomic, strong) NSMutableSet *memberships;
+
+// users whose groups, and groups whose members, are completely known,
+// mapped to when they were loaded
+@property (nonatomic, strong) NSMutableDictionary *loadedUsers;
+@property (nonatomic, strong) NSMutableDictionary *loadedGroups;
+
+@property (nonatomic, strong) NSMutableSet *revalidating;
+
+// the index belongs to one logged-in user and is stored in a file of its own
+@property (nonatomic, strong) NSString *ownerURI;
+@property (nonatomic, strong) NSString *supportPath;
+@property (nonatomic, strong) NSString *storePath;
+@property (nonatomic, strong) dispatch_queue_t saveQueue;
+@property (nonatomic, assign) BOOL saveScheduled;
+
+@end
+
+@implementation MembershipIndex
+
++ (MembershipIndex*) sharedIndex {
+    static MembershipIndex *sharedIndex = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedIndex = [[MembershipIndex alloc] init];
+    });
+    return sharedIndex;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _revalidationInterval = 5 * 60;
+        _revalidating = [NSMutableSet set];
+        _saveQueue = dispatch_queue_create("com.kii.membershipindex.save", DISPATCH_QUEUE_SERIAL);
+
+        _supportPath = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_supportPath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+
+        _memberships = [NSMutableSet set];
+        _loadedUsers = [NSMutableDictionary dictionary];
+        _loadedGroups = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
++ (NSString*) keyForUser:(NSString*)userURI inGroup:(NSString*)groupURI {
+    return [NSString stringWithFormat:@"%@|%@", userURI, groupURI];
+}
+
+#pragma mark - persistence
+
+- (NSDictionary*) snapshot {
+    // called with self locked
+    return @{ @"memberships" : [_memberships allObjects],
+              @"users" : [_loadedUsers copy],
+              @"groups" : [_loadedGroups copy] };
+}
+
+// Switches the index to the current user's file, writing out the previous
+// user's pending changes first. Nothing is kept while logged out, so one
+// user's memberships are never answered to another. Called with self locked.
+- (void) checkCurrentUser {
+
+    NSString *current = [KiiUser currentUser].objectURI;
+    if(current == _ownerURI || [current isEqualToString:_ownerURI]) {
+        return;
+    }
+
+    if(_saveScheduled && _storePath != nil) {
+        [[self snapshot] writeToFile:_storePath atomically:YES];
+    }
+
+    _ownerURI = current;
+    _storePath = nil;
+    [_memberships removeAllObjects];
+    [_loadedUsers removeAllObjects];
+    [_loadedGroups removeAllObjects];
+
+    if(current != nil) {
+
+        NSCharacterSet *unsafe = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+        NSString *name = [[current componentsSeparatedByCharactersInSet:unsafe] componentsJoinedByString:@"_"];
+        _storePath = [_supportPath stringByAppendingPathComponent:[NSString stringWithFormat:@"MembershipIndex-%@.plist", name]];
+
+        NSDictionary *stored = [NSDictionary dictionaryWithContentsOfFile:_storePath];
+        [_memberships addObjectsFromArray:[stored objectForKey:@"memberships"]];
+        [_loadedUsers addEntriesFromDictionary:[stored objectForKey:@"users"]];
+        [_loadedGroups addEntriesFromDictionary:[stored objectForKey:@"groups"]];
+    }
+}
+
+- (void) scheduleSave {
+
+    // called with self locked
+    if(_saveScheduled || _storePath == nil) {
+        return;
+    }
+    _saveScheduled = TRUE;
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(MEMBERSHIP_SAVE_DELAY * NSEC_PER_SEC)), _saveQueue, ^{
+
+        // the path is read with the snapshot, so a user switch in between
+        // can never write one user's index into another's file
+        NSDictionary *snapshot = nil;
+        NSString *path = nil;
+        @synchronized(self) {
+            if(!_saveScheduled) {
+                return;
+            }
+            snapshot = [self snapshot];
+            path = _storePath;
+            _saveScheduled = FALSE;
+        }
+
+        if(path != nil) {
+            [snapshot writeToFile:path atomically:YES];
+        }
+    });
+}
+
+#pragma mark - lookups
+
+- (MembershipState) stateOfUser:(NSString*)userURI inGroup:(NSString*)groupURI {
+
+    if(userURI == nil || groupURI == nil) {
+        return MembershipUnknown;
+    }
+
+    MembershipState state = MembershipUnknown;
+    NSDate *userLoaded = nil;
+    NSDate *groupLoaded = nil;
+
+    @synchronized(self) {
+
+        [self checkCurrentUser];
+
+        userLoaded = [_loadedUsers objectForKey:userURI];
+        groupLoaded = [_loadedGroups objectForKey:groupURI];
+
+        if([_memberships containsObject:[MembershipIndex keyForUser:userURI inGroup:groupURI]]) {
+            state = MembershipMember;
+        } else if(userLoaded != nil || groupLoaded != nil) {
+            state = MembershipNotMember;
+        }
+    }
+
+    // reload whichever side the answer came from, once it has gone stale
+    if(userLoaded != nil) {
+        if(-[userLoaded timeIntervalSinceNow] > _revalidationInterval) {
+            [self revalidate:userURI isGroup:FALSE];
+        }
+    } else if(groupLoaded != nil) {
+        if(-[groupLoaded timeIntervalSinceNow] > _revalidationInterval) {
+            [self revalidate:groupURI isGroup:TRUE];
+        }
+    }
+
+    return state;
+}
+
+- (void) revalidate:(NSString*)uri isGroup:(BOOL)isGroup {
+
+    @synchronized(_revalidating) {
+        if([_revalidating containsObject:uri]) {
+            return;
+        }
+        [_revalidating addObject:uri];
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+
+        if(isGroup) {
+            NSError *error = nil;
+            KiiGroup *group = [KiiGroup groupWithURI:uri];
+            NSArray *members = [group getMemberListSynchronous:&error];
+            if(error == nil && members != nil) {
+                [self setMembers:members ofGroup:group];
+            }
+        } else {
+            [self loadGroupsOfUser:[KiiUser userWithURI:uri] withError:nil];
+        }
+
+        @synchronized(_revalidating) {
+            [_revalidating removeObject:uri];
+        }
+    });
+}
+
+#pragma mark - updates
+
+- (NSArray*) loadGroupsOfUser:(KiiUser*)user withError:(NSError**)error {
+
+    NSError *loadError = nil;
+    NSArray *groups = [user memberOfGroupsSynchronous:&loadError];
+
+    if(loadError == nil && groups != nil) {
+        [self setGroups:groups ofUser:user];
+    }
+
+    if(error != NULL) {
+        *error = loadError;
+    }
+
+    return (loadError == nil) ? groups : nil;
+}
+
+- (void) setGroups:(NSArray*)groups ofUser:(KiiUser*)user {
+
+    NSString *userURI = user.objectURI;
+    if(userURI == nil) {
+        return;
+    }
+
+    NSString *prefix = [userURI stringByAppendingString:@"|"];
+
+    @synchronized(self) {
+
+        [self checkCurrentUser];
+
+        NSMutableSet *stale = [NSMutableSet set];
+        for(NSString *key in _memberships) {
+            if([key hasPrefix:prefix]) {
+                [stale addObject:key];
+            }
+        }
+        [_memberships minusSet:stale];
+
+        for(KiiGroup *group in groups) {
+            if(group.objectURI != nil) {
+                [_memberships addObject:[MembershipIndex keyForUser:userURI inGroup:group.objectURI]];
+            }
+        }
+
+        [_loadedUsers setObject:[NSDate date] forKey:userURI];
+        [self scheduleSave];
+    }
+}
+
+- (void) setMembers:(NSArray*)members ofGroup:(KiiGroup*)group {
+
+    NSString *groupURI = group.objectURI;
+    if(groupURI == nil) {
+        return;
+    }
+
+    NSString *suffix = [@"|" stringByAppendingString:groupURI];
+
+    @synchronized(self) {
+
+        [self checkCurrentUser];
+
+        NSMutableSet *stale = [NSMutableSet set];
+        for(NSString *key in _memberships) {
+            if([key hasSuffix:suffix]) {
+                [stale addObject:key];
+            }
+        }
+        [_memberships minusSet:stale];
+
+        for(KiiUser *member in members) {
+            if(member.objectURI != nil) {
+                [_memberships addObject:[MembershipIndex keyForUser:member.objectURI inGroup:groupURI]];
+            }
+        }
+
+        [_loadedGroups setObject:[NSDate date] forKey:groupURI];
+        [self scheduleSave];
+    }
+}
+
+- (void) addUsers:(NSArray*)users toGroup:(NSString*)groupURI {
+    @synchronized(self) {
+        [self checkCurrentUser];
+        for(KiiUser *user in users) {
+            if(user.objectURI != nil) {
+                [_memberships addObject:[MembershipIndex keyForUser:user.objectURI inGroup:groupURI]];
+            }
+        }
+        [self scheduleSave];
+    }
+}
+
+- (void) removeUsers:(NSArray*)users fromGroup:(NSString*)groupURI {
+    @synchronized(self) {
+        [self checkCurrentUser];
+        for(KiiUser *user in users) {
+            if(user.objectURI != nil) {
+                [_memberships removeObject:[MembershipIndex keyForUser:user.objectURI inGroup:groupURI]];
+            }
+        }
+        [self scheduleSave];
+    }
+}
+
+- (void) deleteGroupSynchronous:(KiiGroup*)group withError:(NSError**)error {
+
+    NSError *deleteError = nil;
+    NSString *groupURI = group.objectURI;
+    [group deleteSynchronous:&deleteError];
+
+    if(deleteError == nil && groupURI != nil) {
+
+        NSString *suffix = [@"|" stringByAppendingString:groupURI];
+
+        @synchronized(self) {
+
+            [self checkCurrentUser];
+
+            NSMutableSet *stale = [NSMutableSet set];
+            for(NSString *key in _memberships) {
+                if([key hasSuffix:suffix]) {
+                    [stale addObject:key];
+                }
+            }
+            [_memberships minusSet:stale];
+
+            [_loadedGroups removeObjectForKey:groupURI];
+            [self scheduleSave];
+        }
+    }
+
+    if(error != NULL) {
+        *error = deleteError;
+    }
+}
+
+- (void) removeAll {
+    @synchronized(self) {
+        [self checkCurrentUser];
+        [_memberships removeAllObjects];
+        [_loadedUsers removeAllObjects];
+        [_loadedGroups removeAllObjects];
+        _saveScheduled = FALSE;
+        if(_storePath != nil) {
+            [[NSFileManager defaultManager] removeItemAtPath:_storePath error:nil];
+        }
+    }
+}
+
+@end
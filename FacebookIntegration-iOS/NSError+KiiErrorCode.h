@@ -0,0 +1,123 @@
+//
+//  NSError+KiiErrorCode.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/** Every KiiError factory in KiiError.h, numbered by this app
+
+ These numbers are not the SDK's error codes, which it does not document. Each value is the "@name ... (Nxx)" family of its factory method in KiiError.h, plus the factory's position within that family, counting from 1: invalidAccessToken is the first User API error, so it is 301. A new SDK release that adds factories gets new numbers at the end of its family. Existing numbers never change.
+
+ The codes the SDK really returns are read from the factory methods at first use and matched by the category, so these values are never compared with [error code].
+ */
+typedef enum {
+    KiiErrorUnknown                     = 0,
+
+    // Application Errors (1xx)
+    KiiErrorInvalidApplication          = 101,
+
+    // Connectivity Errors (2xx)
+    KiiErrorUnableToConnectToInternet   = 201,
+    KiiErrorUnableToParseResponse       = 202,
+    KiiErrorUnauthorizedRequest         = 203,
+
+    // User API Errors (3xx)
+    KiiErrorInvalidAccessToken          = 301,
+    KiiErrorUnableToAuthenticateUser    = 302,
+    KiiErrorUnableToRetrieveUserFileList = 303,
+    KiiErrorInvalidPasswordFormat       = 304,
+    KiiErrorInvalidEmailFormat          = 305,
+    KiiErrorInvalidUserIdentifier       = 306,
+    KiiErrorInvalidUsername             = 307,
+    KiiErrorInvalidUserObject           = 308,
+    KiiErrorInvalidPhoneFormat          = 309,
+    KiiErrorUnableToVerifyUser          = 310,
+    KiiErrorInvalidDisplayName          = 311,
+    KiiErrorUnableToUpdateEmail         = 312,
+    KiiErrorUnableToUpdatePhoneNumber   = 313,
+    KiiErrorInvalidSocialNetworkKey     = 314,
+
+    // File API Errors (4xx)
+    KiiErrorUnableToDeleteFile          = 401,
+    KiiErrorUnableToUploadFile          = 402,
+    KiiErrorLocalFileInvalid            = 403,
+    KiiErrorShreddedFileMustBeInTrash   = 404,
+    KiiErrorFileContainerNotSpecified   = 405,
+
+    // Core Object Errors (5xx)
+    KiiErrorInvalidObjects              = 501,
+    KiiErrorUnableToParseObject         = 502,
+    KiiErrorDuplicateEntry              = 503,
+    KiiErrorInvalidRemotePath           = 504,
+    KiiErrorUnableToDeleteObject        = 505,
+    KiiErrorInvalidObjectType           = 506,
+    KiiErrorUnableToSetObjectToItself   = 507,
+    KiiErrorInvalidAttributeKey         = 508,
+    KiiErrorInvalidContainer            = 509,
+    KiiErrorObjectNotFound              = 510,
+    KiiErrorInvalidURI                  = 511,
+    KiiErrorInvalidGroupName            = 512,
+    KiiErrorPartialACLFailure           = 513,
+
+    // Query Errors (6xx)
+    KiiErrorNoMoreResults               = 601,
+    KiiErrorSingleQueryLimitExceeded    = 602
+} KiiErrorCode;
+
+/** The key for an NSNumber HTTP status code in an error's userInfo
+
+ The SDK's errors never carry one, so this is only set on errors from the app's own HTTP requests, by errorWithHTTPResponse:. It is also looked for in the underlying error.
+ */
+extern NSString * const KiiErrorHTTPStatusKey;
+
+/** The key under which the SDK puts the server's errorCode string, such as "OBJECT_VERSION_IS_STALE", in an error's userInfo */
+extern NSString * const KiiErrorServerCodeKey;
+
+/** Numeric KiiError codes and retry classification
+
+ The KiiError factory methods build a new NSError on every call, and their codes are only meaningful next to another factory result. This category builds each KiiError once, at first use, and maps any NSError back to a KiiErrorCode with a table scan, so error-heavy paths can switch on a number without creating errors or comparing strings.
+ */
+@interface NSError (KiiErrorCode)
+
+/** The shared, preallocated error for a code
+
+ @param code A KiiErrorCode other than KiiErrorUnknown
+ @return The same immutable NSError on every call, nil for an unknown code
+ */
++ (NSError*) kiiErrorWithCode:(KiiErrorCode)code;
+
+
+/** The KiiErrorCode of this error
+
+ @return The code, or KiiErrorUnknown if this is not a KiiError
+ */
+- (KiiErrorCode) kiiErrorCode;
+
+
+/** An error for an HTTP response that failed
+
+ @param response The response to one of the app's own requests
+ @return An NSURLErrorBadServerResponse error with the status under KiiErrorHTTPStatusKey, nil if the status is below 400
+ */
++ (NSError*) errorWithHTTPResponse:(NSHTTPURLResponse*)response;
+
+
+/** The HTTP status code recorded under KiiErrorHTTPStatusKey
+
+ @return The status of this error or of its underlying error, 0 if there is none
+ */
+- (NSInteger) httpStatusCode;
+
+
+/** Whether retrying the failed operation may succeed
+
+ TRUE for connectivity failures, both KiiError ones and NSURLErrorDomain timeouts and lost connections. TRUE for HTTP 5xx, 408 and 429 responses to the app's own requests. The SDK reports a server failure by the server's errorCode under KiiErrorServerCodeKey, not by its status, so an SDK error is only TRUE for the codes the server sends while it is unavailable or overloaded; any other server failure is FALSE. FALSE for validation, authentication and not-found errors, which fail the same way every time, and for unparseable responses, which come back the same from a server that answers with a format the SDK cannot read.
+ @return TRUE if the error is transient
+ */
+- (BOOL) isRetryable;
+
+@end
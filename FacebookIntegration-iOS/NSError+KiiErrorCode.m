@@ -0,0 +1,195 @@
+//
+//  NSError+KiiErrorCode.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "NSError+KiiErrorCode.h"
+
+#import <KiiSDK/Kii.h>
+
+NSString * const KiiErrorHTTPStatusKey = @"KiiErrorHTTPStatusKey";
+NSString * const KiiErrorServerCodeKey = @"server_code";
+
+// the server's errorCode strings for a request it could not serve right now.
+// The SDK passes on the errorCode but not the status it came with
+static NSString * const kTransientServerCodes[] = {
+    @"SERVICE_UNAVAILABLE",
+    @"TOO_MANY_REQUESTS",
+};
+
+typedef struct {
+    KiiErrorCode code;
+    const char *factory;
+    BOOL retryable;
+} KiiErrorDefinition;
+
+static const KiiErrorDefinition kDefinitions[] = {
+    { KiiErrorInvalidApplication,           "invalidApplication",           FALSE },
+    { KiiErrorUnableToConnectToInternet,    "unableToConnectToInternet",    TRUE  },
+    { KiiErrorUnableToParseResponse,        "unableToParseResponse",        FALSE },
+    { KiiErrorUnauthorizedRequest,          "unauthorizedRequest",          FALSE },
+    { KiiErrorInvalidAccessToken,           "invalidAccessToken",           FALSE },
+    { KiiErrorUnableToAuthenticateUser,     "unableToAuthenticateUser",     FALSE },
+    { KiiErrorUnableToRetrieveUserFileList, "unableToRetrieveUserFileList", FALSE },
+    { KiiErrorInvalidPasswordFormat,        "invalidPasswordFormat",        FALSE },
+    { KiiErrorInvalidEmailFormat,           "invalidEmailFormat",           FALSE },
+    { KiiErrorInvalidUserIdentifier,        "invalidUserIdentifier",        FALSE },
+    { KiiErrorInvalidUsername,              "invalidUsername",              FALSE },
+    { KiiErrorInvalidUserObject,            "invalidUserObject",            FALSE },
+    { KiiErrorInvalidPhoneFormat,           "invalidPhoneFormat",           FALSE },
+    { KiiErrorUnableToVerifyUser,           "unableToVerifyUser",           FALSE },
+    { KiiErrorInvalidDisplayName,           "invalidDisplayName",           FALSE },
+    { KiiErrorUnableToUpdateEmail,          "unableToUpdateEmail",          FALSE },
+    { KiiErrorUnableToUpdatePhoneNumber,    "unableToUpdatePhoneNumber",    FALSE },
+    { KiiErrorInvalidSocialNetworkKey,      "invalidSocialNetworkKey",      FALSE },
+    { KiiErrorUnableToDeleteFile,           "unableToDeleteFile",           FALSE },
+    { KiiErrorUnableToUploadFile,           "unableToUploadFile",           FALSE },
+    { KiiErrorLocalFileInvalid,             "localFileInvalid",             FALSE },
+    { KiiErrorShreddedFileMustBeInTrash,    "shreddedFileMustBeInTrash",    FALSE },
+    { KiiErrorFileContainerNotSpecified,    "fileContainerNotSpecified",    FALSE },
+    { KiiErrorInvalidObjects,               "invalidObjects",               FALSE },
+    { KiiErrorUnableToParseObject,          "unableToParseObject",          FALSE },
+    { KiiErrorDuplicateEntry,               "duplicateEntry",               FALSE },
+    { KiiErrorInvalidRemotePath,            "invalidRemotePath",            FALSE },
+    { KiiErrorUnableToDeleteObject,         "unableToDeleteObject",         FALSE },
+    { KiiErrorInvalidObjectType,            "invalidObjectType",            FALSE },
+    { KiiErrorUnableToSetObjectToItself,    "unableToSetObjectToItself",    FALSE },
+    { KiiErrorInvalidAttributeKey,          "invalidAttributeKey",          FALSE },
+    { KiiErrorInvalidContainer,             "invalidContainer",             FALSE },
+    { KiiErrorObjectNotFound,               "objectNotFound",               FALSE },
+    { KiiErrorInvalidURI,                   "invalidURI",                   FALSE },
+    { KiiErrorInvalidGroupName,             "invalidGroupName",             FALSE },
+    { KiiErrorPartialACLFailure,            "partialACLFailure",            FALSE },
+    { KiiErrorNoMoreResults,                "noMoreResults",                FALSE },
+    { KiiErrorSingleQueryLimitExceeded,     "singleQueryLimitExceeded",     FALSE }
+};
+
+#define KII_ERROR_COUNT (sizeof(kDefinitions) / sizeof(kDefinitions[0]))
+
+// built once, in the same order as kDefinitions
+static NSError *kErrors[KII_ERROR_COUNT];
+static NSInteger kSDKCodes[KII_ERROR_COUNT];
+static NSString *kDomain = nil;
+
+static void KiiErrorTableInit(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for(size_t i = 0; i < KII_ERROR_COUNT; i++) {
+            SEL factory = NSSelectorFromString([NSString stringWithUTF8String:kDefinitions[i].factory]);
+            NSError *(*build)(id, SEL) = (NSError *(*)(id, SEL))[KiiError methodForSelector:factory];
+            kErrors[i] = build([KiiError class], factory);
+            kSDKCodes[i] = [kErrors[i] code];
+        }
+        kDomain = [kErrors[0] domain];
+
+        // the reverse lookup only works if the SDK gives every factory its
+        // own code in one domain; if not, the first definition wins
+        for(size_t i = 0; i < KII_ERROR_COUNT; i++) {
+            NSCAssert([[kErrors[i] domain] isEqualToString:kDomain], @"%s is not in the %@ domain", kDefinitions[i].factory, kDomain);
+            for(size_t j = 0; j < i; j++) {
+                NSCAssert(kSDKCodes[i] != kSDKCodes[j], @"%s and %s share SDK code %ld", kDefinitions[j].factory, kDefinitions[i].factory, (long)kSDKCodes[i]);
+            }
+        }
+    });
+}
+
+static NSInteger KiiErrorIndex(NSError *error) {
+
+    KiiErrorTableInit();
+
+    if(error == nil || ![[error domain] isEqualToString:kDomain]) {
+        return -1;
+    }
+
+    NSInteger code = [error code];
+    for(size_t i = 0; i < KII_ERROR_COUNT; i++) {
+        if(kSDKCodes[i] == code) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+@implementation NSError (KiiErrorCode)
+
++ (NSError*) kiiErrorWithCode:(KiiErrorCode)code {
+
+    KiiErrorTableInit();
+
+    for(size_t i = 0; i < KII_ERROR_COUNT; i++) {
+        if(kDefinitions[i].code == code) {
+            return kErrors[i];
+        }
+    }
+
+    return nil;
+}
+
+- (KiiErrorCode) kiiErrorCode {
+    NSInteger index = KiiErrorIndex(self);
+    return (index >= 0) ? kDefinitions[index].code : KiiErrorUnknown;
+}
+
++ (NSError*) errorWithHTTPResponse:(NSHTTPURLResponse*)response {
+
+    if(response.statusCode < 400) {
+        return nil;
+    }
+
+    NSDictionary *userInfo = @{ KiiErrorHTTPStatusKey : @(response.statusCode),
+                                NSLocalizedDescriptionKey : [NSHTTPURLResponse localizedStringForStatusCode:response.statusCode],
+                                NSURLErrorFailingURLErrorKey : response.URL };
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:userInfo];
+}
+
+- (NSInteger) httpStatusCode {
+
+    id status = [[self userInfo] objectForKey:KiiErrorHTTPStatusKey];
+    if([status isKindOfClass:[NSNumber class]]) {
+        return [status integerValue];
+    }
+
+    NSError *underlying = [[self userInfo] objectForKey:NSUnderlyingErrorKey];
+    return [underlying isKindOfClass:[NSError class]] ? [underlying httpStatusCode] : 0;
+}
+
+- (BOOL) isRetryable {
+
+    // overloaded or restarting servers, timeouts and rate limits
+    NSInteger status = [self httpStatusCode];
+    if(status != 0) {
+        return (status >= 500 && status < 600) || status == 408 || status == 429;
+    }
+
+    id serverCode = [[self userInfo] objectForKey:KiiErrorServerCodeKey];
+    if([serverCode isKindOfClass:[NSString class]]) {
+        for(NSUInteger i = 0; i < sizeof(kTransientServerCodes) / sizeof(kTransientServerCodes[0]); i++) {
+            if([serverCode isEqualToString:kTransientServerCodes[i]]) {
+                return TRUE;
+            }
+        }
+    }
+
+    if([[self domain] isEqualToString:NSURLErrorDomain]) {
+        switch([self code]) {
+            case NSURLErrorTimedOut:
+            case NSURLErrorCannotFindHost:
+            case NSURLErrorCannotConnectToHost:
+            case NSURLErrorNetworkConnectionLost:
+            case NSURLErrorDNSLookupFailed:
+            case NSURLErrorNotConnectedToInternet:
+                return TRUE;
+            default:
+                return FALSE;
+        }
+    }
+
+    NSInteger index = KiiErrorIndex(self);
+    return (index >= 0) ? kDefinitions[index].retryable : FALSE;
+}
+
+@end
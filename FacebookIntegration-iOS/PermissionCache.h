@@ -0,0 +1,99 @@
+//
+//  PermissionCache.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <KiiSDK/KiiACLEntry.h>
+
+@class KiiObject, KiiFile;
+
+typedef enum {
+    PermissionUnknown,
+    PermissionGranted,
+    PermissionDenied
+} PermissionState;
+
+/** Local cache of what the current user may do, built from ACL listings
+
+ Entries from listACLEntries are folded, per target, into a bitmask of the actions granted to the current user: directly, through any of the user's groups, through KiiAnyAuthenticatedUser while logged in, or through KiiAnonymousUser. permissionForAction:onTarget: is then a single lookup and bit test, so a write can be rejected locally instead of after a full upload.
+
+ Until the user's groups have been loaded, an action that is only granted to groups reports PermissionUnknown rather than PermissionDenied. Targets expire after timeToLive and then report PermissionUnknown until reloaded. The cache is cleared whenever the current user changes.
+ */
+@interface PermissionCache : NSObject
+
+/** How long a target's permissions are trusted, in seconds. Defaults to 5 minutes */
+@property (nonatomic, assign) NSTimeInterval timeToLive;
+
+/** The shared permission cache
+
+ @return The process-wide PermissionCache instance
+ */
++ (PermissionCache*) sharedCache;
+
+
+/** Fetch the current user's groups with memberOfGroupsSynchronous: and recompute every cached target
+
+ This is a blocking method.
+ @param error An NSError object, set to nil, to test for errors
+ */
+- (void) loadMembershipsSynchronous:(NSError**)error;
+
+
+/** Replace the current user's groups with a list the app already has
+
+ @param groups An array of KiiGroup objects
+ */
+- (void) setMemberships:(NSArray*)groups;
+
+
+/** Cache the result of a listACLEntries call
+
+ @param entries The KiiACLEntry objects returned by the server
+ @param targetURI The objectURI of the object, file or bucket the entries belong to
+ */
+- (void) storeEntries:(NSArray*)entries forTarget:(NSString*)targetURI;
+
+
+/** List and cache the ACL of an object
+
+ This is a blocking method.
+ @param object The object whose ACL should be loaded
+ @param error An NSError object, set to nil, to test for errors
+ */
+- (void) loadObject:(KiiObject*)object withError:(NSError**)error;
+
+
+/** List and cache the ACL of a file
+
+ This is a blocking method.
+ @param file The file whose ACL should be loaded
+ @param error An NSError object, set to nil, to test for errors
+ */
+- (void) loadFile:(KiiFile*)file withError:(NSError**)error;
+
+
+/** Check whether the current user may perform an action
+
+ Never touches the network.
+ @param action The action to check
+ @param targetURI The objectURI of the object, file or bucket
+ @return PermissionUnknown if the target is not cached or has expired, or if only a group grants the action and memberships are not loaded yet
+ */
+- (PermissionState) permissionForAction:(KiiACLAction)action onTarget:(NSString*)targetURI;
+
+
+/** Forget a target, for example after its ACL was changed elsewhere
+
+ @param targetURI The objectURI of the object, file or bucket
+ */
+- (void) invalidateTarget:(NSString*)targetURI;
+
+
+/** Forget every target and membership */
+- (void) invalidateAll;
+
+@end
@@ -0,0 +1,246 @@
+//
+//  PermissionCache.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "PermissionCache.h"
+
+#import <KiiSDK/Kii.h>
+
+/** The raw entries for one target, plus the folded mask for the current user */
+@interface PermissionTarget : NSObject
+
+@property (nonatomic, strong) NSArray *entries;
+@property (nonatomic, strong) NSDate *expiresAt;
+@property (nonatomic, assign) uint32_t grantedMask;
+
+// actions granted to any group, which only count once memberships are known
+@property (nonatomic, assign) uint32_t groupMask;
+
+@end
+
+@implementation PermissionTarget
+@end
+
+
+@interface PermissionCache ()
+
+@property (nonatomic, strong) NSMutableDictionary *targets;
+@property (nonatomic, strong) NSSet *groupURIs;
+@property (nonatomic, assign) BOOL membershipsLoaded;
+@property (nonatomic, strong) NSString *userURI;
+
+@end
+
+@implementation PermissionCache
+
++ (PermissionCache*) sharedCache {
+    static PermissionCache *sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[PermissionCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _timeToLive = 5 * 60;
+        _targets = [NSMutableDictionary dictionary];
+        _groupURIs = [NSSet set];
+    }
+    return self;
+}
+
+#pragma mark - folding
+
+// Must be called with the lock held
+- (void) checkCurrentUser {
+
+    NSString *current = [KiiUser currentUser].objectURI;
+    if(current != _userURI && ![current isEqualToString:_userURI]) {
+        [_targets removeAllObjects];
+        _groupURIs = [NSSet set];
+        _membershipsLoaded = FALSE;
+        _userURI = current;
+    }
+}
+
+// Must be called with the lock held
+- (uint32_t) maskForEntries:(NSArray*)entries {
+
+    uint32_t mask = 0;
+
+    for(KiiACLEntry *entry in entries) {
+
+        if(!entry.grant) {
+            continue;
+        }
+
+        id subject = entry.subject;
+        BOOL applies = FALSE;
+
+        if([subject isKindOfClass:[KiiAnonymousUser class]]) {
+            applies = TRUE;
+        } else if([subject isKindOfClass:[KiiAnyAuthenticatedUser class]]) {
+            applies = (_userURI != nil);
+        } else if([subject isKindOfClass:[KiiUser class]]) {
+            applies = (_userURI != nil && [[subject objectURI] isEqualToString:_userURI]);
+        } else if([subject isKindOfClass:[KiiGroup class]]) {
+            applies = [_groupURIs containsObject:[subject objectURI]];
+        }
+
+        if(applies) {
+            mask |= (1u << entry.action);
+        }
+    }
+
+    return mask;
+}
+
++ (uint32_t) groupMaskForEntries:(NSArray*)entries {
+
+    uint32_t mask = 0;
+
+    for(KiiACLEntry *entry in entries) {
+        if(entry.grant && [entry.subject isKindOfClass:[KiiGroup class]]) {
+            mask |= (1u << entry.action);
+        }
+    }
+
+    return mask;
+}
+
+#pragma mark - loading
+
+- (void) setMemberships:(NSArray*)groups {
+
+    NSMutableSet *uris = [NSMutableSet setWithCapacity:groups.count];
+    for(KiiGroup *group in groups) {
+        if(group.objectURI != nil) {
+            [uris addObject:group.objectURI];
+        }
+    }
+
+    @synchronized(self) {
+        [self checkCurrentUser];
+        _groupURIs = uris;
+        _membershipsLoaded = TRUE;
+        for(PermissionTarget *target in [_targets allValues]) {
+            target.grantedMask = [self maskForEntries:target.entries];
+        }
+    }
+}
+
+- (void) loadMembershipsSynchronous:(NSError**)error {
+
+    NSError *memberError = nil;
+    NSArray *groups = [[KiiUser currentUser] memberOfGroupsSynchronous:&memberError];
+
+    if(memberError == nil) {
+        [self setMemberships:groups];
+    }
+
+    if(error != NULL) {
+        *error = memberError;
+    }
+}
+
+- (void) storeEntries:(NSArray*)entries forTarget:(NSString*)targetURI {
+
+    if(targetURI == nil) {
+        return;
+    }
+
+    @synchronized(self) {
+        [self checkCurrentUser];
+
+        PermissionTarget *target = [[PermissionTarget alloc] init];
+        target.entries = [entries copy];
+        target.expiresAt = [NSDate dateWithTimeIntervalSinceNow:_timeToLive];
+        target.grantedMask = [self maskForEntries:target.entries];
+        target.groupMask = [PermissionCache groupMaskForEntries:target.entries];
+
+        [_targets setObject:target forKey:targetURI];
+    }
+}
+
+- (void) loadACL:(KiiACL*)acl forTarget:(NSString*)targetURI withError:(NSError**)error {
+
+    NSError *listError = nil;
+    NSArray *entries = [acl listACLEntriesSynchronous:&listError];
+
+    if(listError == nil) {
+        [self storeEntries:entries forTarget:targetURI];
+    }
+
+    if(error != NULL) {
+        *error = listError;
+    }
+}
+
+- (void) loadObject:(KiiObject*)object withError:(NSError**)error {
+    [self loadACL:object.objectACL forTarget:object.objectURI withError:error];
+}
+
+- (void) loadFile:(KiiFile*)file withError:(NSError**)error {
+    [self loadACL:file.fileACL forTarget:file.objectURI withError:error];
+}
+
+#pragma mark - queries
+
+- (PermissionState) permissionForAction:(KiiACLAction)action onTarget:(NSString*)targetURI {
+
+    if(targetURI == nil) {
+        return PermissionUnknown;
+    }
+
+    @synchronized(self) {
+        [self checkCurrentUser];
+
+        PermissionTarget *target = [_targets objectForKey:targetURI];
+        if(target == nil) {
+            return PermissionUnknown;
+        }
+
+        if([target.expiresAt timeIntervalSinceNow] <= 0) {
+            [_targets removeObjectForKey:targetURI];
+            return PermissionUnknown;
+        }
+
+        uint32_t bit = (1u << action);
+        if(target.grantedMask & bit) {
+            return PermissionGranted;
+        }
+
+        // a group grant may apply, but the user's groups are not known yet
+        if(!_membershipsLoaded && (target.groupMask & bit)) {
+            return PermissionUnknown;
+        }
+
+        return PermissionDenied;
+    }
+}
+
+- (void) invalidateTarget:(NSString*)targetURI {
+    if(targetURI == nil) {
+        return;
+    }
+    @synchronized(self) {
+        [_targets removeObjectForKey:targetURI];
+    }
+}
+
+- (void) invalidateAll {
+    @synchronized(self) {
+        [_targets removeAllObjects];
+        _groupURIs = [NSSet set];
+        _membershipsLoaded = FALSE;
+    }
+}
+
+@end
@@ -0,0 +1,64 @@
+//
+//  PublishedURLCache.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiFile;
+
+typedef void (^PublishedURLCompletion)(NSString *url, NSError *error);
+
+/** Expiry-aware cache of published KiiFile URLs
+
+ URLs are cached per file and lifetime. A cached URL is handed back as long as it stays valid for at least safetyMargin; once less than refreshFraction of its lifetime remains, a replacement is published in the background so callers rarely wait on the network. Non-expiring URLs are cached until invalidated. Concurrent requests for the same file and lifetime share a single publish. The cache is persisted across launches.
+ */
+@interface PublishedURLCache : NSObject
+
+/** The minimum remaining validity of a URL that is handed back. Defaults to 5 minutes
+
+ For short lifetimes the margin is clamped to half of lifetime * refreshFraction, so URLs with a lifetime at or below the margin are still cached.
+ */
+@property (nonatomic, assign) NSTimeInterval safetyMargin;
+
+/** The fraction of a URL's lifetime below which it is refreshed in the background. Defaults to 0.25 */
+@property (nonatomic, assign) double refreshFraction;
+
+/** The shared URL cache
+
+ @return The process-wide PublishedURLCache instance
+ */
++ (PublishedURLCache*) sharedCache;
+
+
+/** Get a published URL for a file
+
+ Returns a cached URL if one is valid, otherwise publishes the file. This is a blocking method only when no valid URL is cached.
+ @param file The file to publish. Must exist on the server
+ @param lifetime How long a newly published URL should stay valid, in seconds. 0 publishes a URL that never expires
+ @param error An NSError object, passed by reference. If the error is nil, the request was successful
+ @return The published URL, nil on failure
+ */
+- (NSString*) publishedURLForFile:(KiiFile*)file withLifetime:(NSTimeInterval)lifetime andError:(NSError**)error;
+
+
+/** Get a published URL for a file
+
+ This is a non-blocking method.
+ @param file The file to publish. Must exist on the server
+ @param lifetime How long a newly published URL should stay valid, in seconds. 0 publishes a URL that never expires
+ @param completion The block called on the main thread with the URL, or an error
+ */
+- (void) publishedURLForFile:(KiiFile*)file withLifetime:(NSTimeInterval)lifetime andCompletion:(PublishedURLCompletion)completion;
+
+
+/** Forget every cached URL for a file, for example after its body changes or it is deleted
+
+ @param file The file to forget
+ */
+- (void) invalidateFile:(KiiFile*)file;
+
+@end
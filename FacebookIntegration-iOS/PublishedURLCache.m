@@ -0,0 +1,261 @@
+//
+//  PublishedURLCache.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "PublishedURLCache.h"
+
+#import <KiiSDK/Kii.h>
+
+/** One publish request, shared by every caller asking for the same key while it runs */
+@interface PublishCall : NSObject
+
+@property (nonatomic, strong) dispatch_group_t done;
+@property (nonatomic, strong) NSString *url;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation PublishCall
+@end
+
+
+@interface PublishedURLCache ()
+
+@property (nonatomic, strong) NSMutableDictionary *entries;
+@property (nonatomic, strong) NSMutableSet *refreshing;
+@property (nonatomic, strong) NSMutableDictionary *inFlight;
+@property (nonatomic, strong) NSString *storePath;
+
+@end
+
+@implementation PublishedURLCache
+
++ (PublishedURLCache*) sharedCache {
+    static PublishedURLCache *sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[PublishedURLCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _safetyMargin = 5 * 60;
+        _refreshFraction = 0.25;
+        _refreshing = [NSMutableSet set];
+        _inFlight = [NSMutableDictionary dictionary];
+
+        NSString *support = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        [[NSFileManager defaultManager] createDirectoryAtPath:support
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        _storePath = [support stringByAppendingPathComponent:@"PublishedURLs.plist"];
+
+        _entries = [NSMutableDictionary dictionaryWithContentsOfFile:_storePath];
+        if(_entries == nil) {
+            _entries = [NSMutableDictionary dictionary];
+        }
+
+        [self pruneExpiredEntries];
+    }
+    return self;
+}
+
+#pragma mark - entries
+
++ (NSString*) keyForFile:(KiiFile*)file withLifetime:(NSTimeInterval)lifetime {
+    return [NSString stringWithFormat:@"%@|%.0f", file.objectURI, lifetime];
+}
+
+- (void) pruneExpiredEntries {
+    @synchronized(_entries) {
+        NSDate *now = [NSDate date];
+        for(NSString *key in [_entries allKeys]) {
+            NSDate *expiresAt = [[_entries objectForKey:key] objectForKey:@"expiresAt"];
+            if(expiresAt != nil && [expiresAt compare:now] != NSOrderedDescending) {
+                [_entries removeObjectForKey:key];
+            }
+        }
+    }
+}
+
+- (void) storeURL:(NSString*)url withExpiry:(NSDate*)expiresAt forKey:(NSString*)key {
+    @synchronized(_entries) {
+        NSMutableDictionary *entry = [NSMutableDictionary dictionaryWithObject:url forKey:@"url"];
+        if(expiresAt != nil) {
+            [entry setObject:expiresAt forKey:@"expiresAt"];
+        }
+        [_entries setObject:entry forKey:key];
+        [_entries writeToFile:_storePath atomically:YES];
+    }
+}
+
+- (void) invalidateFile:(KiiFile*)file {
+    @synchronized(_entries) {
+        NSString *prefix = [file.objectURI stringByAppendingString:@"|"];
+        for(NSString *key in [_entries allKeys]) {
+            if([key hasPrefix:prefix]) {
+                [_entries removeObjectForKey:key];
+            }
+        }
+        [_entries writeToFile:_storePath atomically:YES];
+    }
+}
+
+#pragma mark - publishing
+
+- (NSString*) publishFile:(KiiFile*)file
+             withLifetime:(NSTimeInterval)lifetime
+                   forKey:(NSString*)key
+                 andError:(NSError**)error {
+
+    NSError *publishError = nil;
+    NSString *url = nil;
+    NSDate *expiresAt = nil;
+
+    if(lifetime > 0) {
+        expiresAt = [NSDate dateWithTimeIntervalSinceNow:lifetime];
+        url = [file publishSynchronous:&publishError expiresAt:expiresAt];
+    } else {
+        url = [file publishSynchronous:&publishError];
+    }
+
+    if(publishError == nil && url != nil) {
+        [self storeURL:url withExpiry:expiresAt forKey:key];
+    }
+
+    if(error != NULL) {
+        *error = publishError;
+    }
+
+    return url;
+}
+
+// Publishes at most once per key at a time - callers arriving while a
+// publish is running wait for it and share its URL.
+- (NSString*) publishOnceFile:(KiiFile*)file
+                 withLifetime:(NSTimeInterval)lifetime
+                       forKey:(NSString*)key
+                     andError:(NSError**)error {
+
+    PublishCall *call = nil;
+    BOOL leader = FALSE;
+
+    @synchronized(_inFlight) {
+        call = [_inFlight objectForKey:key];
+        if(call == nil) {
+            call = [[PublishCall alloc] init];
+            call.done = dispatch_group_create();
+            dispatch_group_enter(call.done);
+            [_inFlight setObject:call forKey:key];
+            leader = TRUE;
+        }
+    }
+
+    if(leader) {
+
+        NSError *publishError = nil;
+        call.url = [self publishFile:file withLifetime:lifetime forKey:key andError:&publishError];
+        call.error = publishError;
+
+        @synchronized(_inFlight) {
+            [_inFlight removeObjectForKey:key];
+        }
+        dispatch_group_leave(call.done);
+
+    } else {
+        dispatch_group_wait(call.done, DISPATCH_TIME_FOREVER);
+    }
+
+    if(error != NULL) {
+        *error = call.error;
+    }
+
+    return call.url;
+}
+
+// A URL is handed back while it has more than this left. Short lifetimes
+// shrink the margin, so it always falls after the background refresh point
+// and a URL shorter than the configured margin can still be cached.
+- (NSTimeInterval) marginForLifetime:(NSTimeInterval)lifetime {
+    return MIN(_safetyMargin, lifetime * _refreshFraction / 2);
+}
+
+- (void) refreshFileInBackground:(KiiFile*)file withLifetime:(NSTimeInterval)lifetime forKey:(NSString*)key {
+
+    @synchronized(_refreshing) {
+        if([_refreshing containsObject:key]) {
+            return;
+        }
+        [_refreshing addObject:key];
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+
+        // a failed refresh leaves the old URL in place until it falls inside
+        // the safety margin, at which point callers publish synchronously
+        [self publishOnceFile:file withLifetime:lifetime forKey:key andError:nil];
+
+        @synchronized(_refreshing) {
+            [_refreshing removeObject:key];
+        }
+    });
+}
+
+- (NSString*) publishedURLForFile:(KiiFile*)file withLifetime:(NSTimeInterval)lifetime andError:(NSError**)error {
+
+    NSString *key = [PublishedURLCache keyForFile:file withLifetime:lifetime];
+
+    NSDictionary *entry = nil;
+    @synchronized(_entries) {
+        entry = [_entries objectForKey:key];
+    }
+
+    if(entry != nil) {
+
+        NSDate *expiresAt = [entry objectForKey:@"expiresAt"];
+        if(expiresAt == nil) {
+            if(error != NULL) {
+                *error = nil;
+            }
+            return [entry objectForKey:@"url"];
+        }
+
+        NSTimeInterval remaining = [expiresAt timeIntervalSinceNow];
+        if(remaining > [self marginForLifetime:lifetime]) {
+
+            if(remaining < lifetime * _refreshFraction) {
+                [self refreshFileInBackground:file withLifetime:lifetime forKey:key];
+            }
+
+            if(error != NULL) {
+                *error = nil;
+            }
+            return [entry objectForKey:@"url"];
+        }
+    }
+
+    return [self publishOnceFile:file withLifetime:lifetime forKey:key andError:error];
+}
+
+- (void) publishedURLForFile:(KiiFile*)file withLifetime:(NSTimeInterval)lifetime andCompletion:(PublishedURLCompletion)completion {
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        NSError *error = nil;
+        NSString *url = [self publishedURLForFile:file withLifetime:lifetime andError:&error];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(url, error);
+        });
+    });
+}
+
+@end
@@ -0,0 +1,76 @@
+//
+//  RetryPolicy.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/** A blocking SDK call to retry. Must be idempotent - it may run more than once */
+typedef id (^RetryableOperation)(NSError **error);
+
+typedef void (^RetryCompletion)(id result, NSError *error);
+
+/** Retries idempotent SDK calls on transient failures
+
+ An operation that fails with an error for which NSError isRetryable is TRUE is run again after an exponential backoff with full jitter: a random delay between zero and min(maxDelay, baseDelay * 2^retry). Other errors are returned at once.
+
+ Retries draw on a budget shared by every operation using the policy. Each call adds budgetRatio to the budget, up to budgetCapacity, and each retry spends one. While the budget is empty, failures are returned without retrying, so a server outage cannot be multiplied by clients retrying in a loop.
+ */
+@interface RetryPolicy : NSObject
+
+/** The maximum number of attempts per call, including the first. Defaults to 4 */
+@property (nonatomic, assign) NSUInteger maxAttempts;
+
+/** The backoff before the first retry, before jitter, in seconds. Defaults to 0.2 */
+@property (nonatomic, assign) NSTimeInterval baseDelay;
+
+/** The upper bound of any backoff, in seconds. Defaults to 10 */
+@property (nonatomic, assign) NSTimeInterval maxDelay;
+
+/** The number of retries each call earns for the budget. Defaults to 0.1 */
+@property (nonatomic, assign) double budgetRatio;
+
+/** The most retries the budget can hold. Defaults to 10 */
+@property (nonatomic, assign) double budgetCapacity;
+
+/** The shared retry policy
+
+ @return The process-wide RetryPolicy instance
+ */
++ (RetryPolicy*) sharedPolicy;
+
+
+/** Run an operation, retrying transient failures
+
+ This is a blocking method, and sleeps between attempts.
+ @param operation The idempotent operation to run
+ @param error An NSError object, set to nil, to test for errors. The error of the last attempt
+ @return The result of the successful attempt, nil on failure
+ */
+- (id) performSynchronous:(RetryableOperation)operation withError:(NSError**)error;
+
+
+/** Run an operation, retrying transient failures
+
+ This is a non-blocking method. No thread waits out the backoff: each attempt runs on a global queue, and the next one is scheduled with dispatch_after.
+ @param operation The idempotent operation to run
+ @param completion The block called on the main thread with the result or the last error
+ */
+- (void) perform:(RetryableOperation)operation withCompletion:(RetryCompletion)completion;
+
+
+/** Counters for the calls made through this policy
+
+ Keys are "calls", "attempts", "retries", "budgetDenied" (retries skipped for lack of budget), "exhausted" (calls that failed after maxAttempts), "retryDelay" (total seconds spent in backoff) and "budget" (retries currently available).
+ @return A snapshot of the counters
+ */
+- (NSDictionary*) metrics;
+
+
+/** Reset the counters and refill the budget */
+- (void) resetMetrics;
+
+@end
@@ -0,0 +1,200 @@
+//
+//  RetryPolicy.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "RetryPolicy.h"
+
+#import "NSError+KiiErrorCode.h"
+
+@interface RetryPolicy ()
+
+@property (nonatomic, assign) double budget;
+
+@property (nonatomic, assign) NSUInteger calls;
+@property (nonatomic, assign) NSUInteger attempts;
+@property (nonatomic, assign) NSUInteger retries;
+@property (nonatomic, assign) NSUInteger budgetDenied;
+@property (nonatomic, assign) NSUInteger exhausted;
+@property (nonatomic, assign) NSTimeInterval retryDelay;
+
+@end
+
+@implementation RetryPolicy
+
++ (RetryPolicy*) sharedPolicy {
+    static RetryPolicy *sharedPolicy = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedPolicy = [[RetryPolicy alloc] init];
+    });
+    return sharedPolicy;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _maxAttempts = 4;
+        _baseDelay = 0.2;
+        _maxDelay = 10;
+        _budgetRatio = 0.1;
+        _budgetCapacity = 10;
+        _budget = _budgetCapacity;
+    }
+    return self;
+}
+
+#pragma mark - budget
+
+// Takes one retry from the budget, or returns FALSE if there is none
+- (BOOL) withdrawRetry {
+    @synchronized(self) {
+        if(_budget < 1) {
+            _budgetDenied++;
+            return FALSE;
+        }
+        _budget -= 1;
+        _retries++;
+        return TRUE;
+    }
+}
+
+- (NSTimeInterval) backoffForRetry:(NSUInteger)retry {
+
+    double ceiling = MIN(_maxDelay, _baseDelay * pow(2, retry));
+
+    // full jitter: anywhere between no wait and the exponential ceiling
+    return ceiling * ((double)arc4random_uniform(UINT32_MAX) / UINT32_MAX);
+}
+
+#pragma mark - running
+
+- (void) beginCall {
+    @synchronized(self) {
+        _calls++;
+        _budget = MIN(_budgetCapacity, _budget + _budgetRatio);
+    }
+}
+
+// Decides whether a failed attempt is run again, and after how long.
+// Spends a retry from the budget when it is
+- (BOOL) shouldRetryError:(NSError*)error afterAttempt:(NSUInteger)attempt delay:(NSTimeInterval*)delay {
+
+    if(error == nil || ![error isRetryable]) {
+        return FALSE;
+    }
+
+    if(attempt + 1 >= MAX(_maxAttempts, 1)) {
+        @synchronized(self) {
+            _exhausted++;
+        }
+        return FALSE;
+    }
+
+    if(![self withdrawRetry]) {
+        return FALSE;
+    }
+
+    *delay = [self backoffForRetry:attempt];
+    @synchronized(self) {
+        _retryDelay += *delay;
+    }
+    return TRUE;
+}
+
+- (id) performSynchronous:(RetryableOperation)operation withError:(NSError**)error {
+
+    [self beginCall];
+
+    NSError *lastError = nil;
+    id result = nil;
+    NSTimeInterval delay = 0;
+
+    for(NSUInteger attempt = 0; ; attempt++) {
+
+        @synchronized(self) {
+            _attempts++;
+        }
+
+        lastError = nil;
+        result = operation(&lastError);
+
+        if(![self shouldRetryError:lastError afterAttempt:attempt delay:&delay]) {
+            break;
+        }
+
+        // the caller is blocked on the result anyway
+        [NSThread sleepForTimeInterval:delay];
+    }
+
+    if(error != NULL) {
+        *error = lastError;
+    }
+
+    return (lastError == nil) ? result : nil;
+}
+
+- (void) runAttempt:(NSUInteger)attempt of:(RetryableOperation)operation withCompletion:(RetryCompletion)completion {
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        @synchronized(self) {
+            _attempts++;
+        }
+
+        NSError *error = nil;
+        id result = operation(&error);
+
+        // the backoff holds no thread: the next attempt is scheduled instead
+        NSTimeInterval delay = 0;
+        if([self shouldRetryError:error afterAttempt:attempt delay:&delay]) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)),
+                           dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                [self runAttempt:attempt + 1 of:operation withCompletion:completion];
+            });
+            return;
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if(completion != nil) {
+                completion((error == nil) ? result : nil, error);
+            }
+        });
+    });
+}
+
+- (void) perform:(RetryableOperation)operation withCompletion:(RetryCompletion)completion {
+    [self beginCall];
+    [self runAttempt:0 of:[operation copy] withCompletion:[completion copy]];
+}
+
+#pragma mark - metrics
+
+- (NSDictionary*) metrics {
+    @synchronized(self) {
+        return @{ @"calls" : @(_calls),
+                  @"attempts" : @(_attempts),
+                  @"retries" : @(_retries),
+                  @"budgetDenied" : @(_budgetDenied),
+                  @"exhausted" : @(_exhausted),
+                  @"retryDelay" : @(_retryDelay),
+                  @"budget" : @(_budget) };
+    }
+}
+
+- (void) resetMetrics {
+    @synchronized(self) {
+        _calls = 0;
+        _attempts = 0;
+        _retries = 0;
+        _budgetDenied = 0;
+        _exhausted = 0;
+        _retryDelay = 0;
+        _budget = _budgetCapacity;
+    }
+}
+
+@end
@@ -0,0 +1,77 @@
+//
+//  SessionStore.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiUser;
+
+typedef void (^SessionValidated)(KiiUser *user, NSError *error);
+
+typedef enum {
+    /** The server accepted the stored token, and the user is logged in */
+    SessionValidationAccepted,
+    /** The token could not be checked, for example while offline. The session is kept for the next launch */
+    SessionValidationDeferred,
+    /** The server rejected the token. The session was removed and the user must log in again */
+    SessionValidationRejected,
+    /** A new login or a logout replaced the stored session while the old token was being checked. The newer state is left untouched */
+    SessionValidationSuperseded
+} SessionValidationResult;
+
+/** Posted on the main thread when a restored session has been validated. The object is the KiiUser, nil unless the token was accepted. The userInfo contains SessionStoreValidationResultKey, and SessionStoreErrorKey if validation failed */
+extern NSString * const SessionStoreDidValidateNotification;
+
+/** An NSNumber holding the SessionValidationResult */
+extern NSString * const SessionStoreValidationResultKey;
+
+/** The NSError returned by the server, if any */
+extern NSString * const SessionStoreErrorKey;
+
+/** Persists the authenticated session in the keychain for an instant cold start
+
+ After a login, the user's access token and a snapshot of their fields are written to the keychain. On the next launch the snapshot is available immediately, so screens can render the user before any network traffic, while the token is validated with authenticateWithTokenSynchronous: in the background. Once validation finishes, [KiiUser currentUser] is set and authenticated requests can be made.
+ */
+@interface SessionStore : NSObject
+
+/** The user fields saved with the last session, available before validation finishes. Keys are the KiiUser property names. nil if no session is stored */
+@property (readonly) NSDictionary *snapshot;
+
+/** TRUE once the restored token has been accepted by the server */
+@property (readonly) BOOL validated;
+
+/** Seconds from restoreSession to the server accepting the token, after which authenticated requests can be made. Only set when the token is accepted; 0 otherwise */
+@property (readonly) NSTimeInterval timeToAuthenticated;
+
+/** The shared session store
+
+ @return The process-wide SessionStore instance
+ */
++ (SessionStore*) sharedStore;
+
+
+/** Save the session of a logged in user
+
+ Should be called whenever a login succeeds.
+ @param user The authenticated user. Its accessToken must be set
+ */
+- (void) saveSessionForUser:(KiiUser*)user;
+
+
+/** Load the stored snapshot and validate the stored token in the background
+
+ Should be called in application:didFinishLaunchingWithOptions:, after Kii has been initialized. The result is only written back to the keychain if it still holds the token that was checked, so a login that finishes first is never overwritten. This is a non-blocking method.
+ @param completion The block called on the main thread once validation finishes. Not called if no session is stored
+ @return TRUE if a stored session was found
+ */
+- (BOOL) restoreSessionWithCompletion:(SessionValidated)completion;
+
+
+/** Remove the stored session and the user's MembershipIndex, and log the current user out */
+- (void) clearSession;
+
+@end
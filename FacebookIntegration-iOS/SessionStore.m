@@ -0,0 +1,222 @@
+//
+//  SessionStore.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "SessionStore.h"
+
+#import <KiiSDK/Kii.h>
+#import <Security/Security.h>
+
+#import "GroupMemberPager.h"
+#import "MembershipIndex.h"
+#import "NSError+KiiErrorCode.h"
+
+NSString * const SessionStoreDidValidateNotification = @"SessionStoreDidValidateNotification";
+NSString * const SessionStoreValidationResultKey = @"SessionStoreValidationResultKey";
+NSString * const SessionStoreErrorKey = @"SessionStoreErrorKey";
+
+static NSString * const kSessionAccount = @"KiiSession";
+
+@interface SessionStore ()
+
+@property (strong) NSDictionary *snapshot;
+@property (assign) BOOL validated;
+@property (assign) NSTimeInterval timeToAuthenticated;
+
+@end
+
+@implementation SessionStore
+
++ (SessionStore*) sharedStore {
+    static SessionStore *sharedStore = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedStore = [[SessionStore alloc] init];
+    });
+    return sharedStore;
+}
+
+#pragma mark - keychain
+
++ (NSMutableDictionary*) keychainQuery {
+    NSString *service = [[[NSBundle mainBundle] bundleIdentifier] stringByAppendingString:@".session"];
+    return [NSMutableDictionary dictionaryWithObjectsAndKeys:
+            (__bridge id)kSecClassGenericPassword, (__bridge id)kSecClass,
+            service, (__bridge id)kSecAttrService,
+            kSessionAccount, (__bridge id)kSecAttrAccount,
+            nil];
+}
+
++ (NSDictionary*) readKeychain {
+
+    NSMutableDictionary *query = [SessionStore keychainQuery];
+    [query setObject:(__bridge id)kCFBooleanTrue forKey:(__bridge id)kSecReturnData];
+    [query setObject:(__bridge id)kSecMatchLimitOne forKey:(__bridge id)kSecMatchLimit];
+
+    CFTypeRef result = NULL;
+    if(SecItemCopyMatching((__bridge CFDictionaryRef)query, &result) != errSecSuccess || result == NULL) {
+        return nil;
+    }
+
+    NSData *data = (__bridge_transfer NSData*)result;
+    id session = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+
+    return [session isKindOfClass:[NSDictionary class]] ? session : nil;
+}
+
++ (void) writeKeychain:(NSDictionary*)session {
+
+    NSMutableDictionary *query = [SessionStore keychainQuery];
+    SecItemDelete((__bridge CFDictionaryRef)query);
+
+    if(session == nil) {
+        return;
+    }
+
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:session format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    if(data == nil) {
+        return;
+    }
+
+    [query setObject:data forKey:(__bridge id)kSecValueData];
+    [query setObject:(__bridge id)kSecAttrAccessibleAfterFirstUnlockThisDeviceOnly forKey:(__bridge id)kSecAttrAccessible];
+    SecItemAdd((__bridge CFDictionaryRef)query, NULL);
+}
+
+#pragma mark - sessions
+
++ (NSDictionary*) snapshotOfUser:(KiiUser*)user {
+
+    NSMutableDictionary *snapshot = [NSMutableDictionary dictionary];
+
+    // plist-safe fields only - nil values are simply left out
+    NSArray *keys = @[ @"uuid", @"username", @"displayName", @"email", @"phoneNumber",
+                       @"country", @"objectURI", @"created", @"modified" ];
+    for(NSString *key in keys) {
+        id value = [user valueForKey:key];
+        if(value != nil) {
+            [snapshot setObject:value forKey:key];
+        }
+    }
+    [snapshot setObject:@(user.emailVerified) forKey:@"emailVerified"];
+    [snapshot setObject:@(user.phoneVerified) forKey:@"phoneVerified"];
+
+    return snapshot;
+}
+
+- (void) saveSessionForUser:(KiiUser*)user {
+
+    if(user.accessToken == nil) {
+        return;
+    }
+
+    NSDictionary *snapshot = [SessionStore snapshotOfUser:user];
+
+    @synchronized(self) {
+        [SessionStore writeKeychain:@{ @"accessToken" : user.accessToken, @"user" : snapshot }];
+        self.snapshot = snapshot;
+        self.validated = TRUE;
+    }
+}
+
+- (BOOL) restoreSessionWithCompletion:(SessionValidated)completion {
+
+    NSTimeInterval started = [NSDate timeIntervalSinceReferenceDate];
+
+    NSDictionary *session = [SessionStore readKeychain];
+    NSString *token = [session objectForKey:@"accessToken"];
+    if(token == nil) {
+        return FALSE;
+    }
+
+    self.snapshot = [session objectForKey:@"user"];
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0), ^{
+
+        NSError *error = nil;
+        KiiUser *user = [KiiUser authenticateWithTokenSynchronous:token andError:&error];
+        SessionValidationResult result = SessionValidationDeferred;
+        NSString *newerToken = nil;
+        BOOL clearedMeanwhile = FALSE;
+
+        @synchronized(self) {
+
+            // a login that finished while this token was checked has already
+            // written its own session, which must not be replaced or cleared
+            NSString *stored = [[SessionStore readKeychain] objectForKey:@"accessToken"];
+
+            if(![stored isEqualToString:token]) {
+
+                newerToken = (error == nil) ? stored : nil;
+                clearedMeanwhile = (error == nil && stored == nil);
+                result = SessionValidationSuperseded;
+                user = nil;
+
+            } else if(error == nil && user != nil) {
+
+                // pick up any fields that changed on another device
+                NSDictionary *snapshot = [SessionStore snapshotOfUser:user];
+                [SessionStore writeKeychain:@{ @"accessToken" : token, @"user" : snapshot }];
+                self.snapshot = snapshot;
+                self.validated = TRUE;
+                self.timeToAuthenticated = [NSDate timeIntervalSinceReferenceDate] - started;
+                result = SessionValidationAccepted;
+
+            } else if([error kiiErrorCode] == KiiErrorInvalidAccessToken || [error kiiErrorCode] == KiiErrorUnauthorizedRequest) {
+
+                // the token is dead - offline and server errors keep the session
+                // so the next launch can try again
+                [SessionStore writeKeychain:nil];
+                self.snapshot = nil;
+                result = SessionValidationRejected;
+                user = nil;
+
+            } else {
+                user = nil;
+            }
+        }
+
+        // authenticating the old token also made it the SDK's current user,
+        // so hand that back to the newer session, or to no one after a logout
+        if(newerToken != nil) {
+            [KiiUser authenticateWithTokenSynchronous:newerToken andError:nil];
+        } else if(clearedMeanwhile) {
+            [KiiUser logOut];
+        }
+
+        NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:@(result) forKey:SessionStoreValidationResultKey];
+        if(error != nil) {
+            [userInfo setObject:error forKey:SessionStoreErrorKey];
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+
+            if(completion != nil) {
+                completion(user, error);
+            }
+
+            [[NSNotificationCenter defaultCenter] postNotificationName:SessionStoreDidValidateNotification object:user userInfo:userInfo];
+        });
+    });
+
+    return TRUE;
+}
+
+- (void) clearSession {
+    @synchronized(self) {
+        [SessionStore writeKeychain:nil];
+        self.snapshot = nil;
+        self.validated = FALSE;
+    }
+
+    // the user's memberships and rosters must not outlive their session on this device
+    [[MembershipIndex sharedIndex] removeAll];
+    [GroupMemberPager removeAllRosters];
+    [KiiUser logOut];
+}
+
+@end
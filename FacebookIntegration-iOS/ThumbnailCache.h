@@ -0,0 +1,75 @@
+//
+//  ThumbnailCache.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <UIKit/UIKit.h>
+
+@class KiiFile;
+
+typedef void (^ThumbnailCompletion)(UIImage *thumbnail, NSError *error);
+
+/** Asynchronous thumbnail pipeline for KiiFile images
+
+ A replacement for KiiUtilities generateThumbnail:ofSize: that never decodes on the calling thread. Images are decoded at reduced resolution on a concurrent queue sized to the number of active cores, and the results are kept in a memory cache backed by a disk cache, both keyed by file and size. Concurrent requests for the same thumbnail are coalesced into a single decode.
+
+ Completion blocks are always called on the main thread.
+ */
+@interface ThumbnailCache : NSObject
+
+/** The maximum number of decoded bytes held in memory. Defaults to 16MB */
+@property (nonatomic, assign) NSUInteger memoryLimit;
+
+/** The shared thumbnail cache
+
+ @return The process-wide ThumbnailCache instance
+ */
++ (ThumbnailCache*) sharedCache;
+
+
+/** Get a thumbnail from memory, if one is cached
+
+ This method never touches the disk or decodes, so it is safe to call while configuring a cell.
+ @param file The file the thumbnail represents
+ @param thumbSize The maximum width or height of the thumbnail, in points
+ @return The cached thumbnail, nil if it is not in memory
+ */
+- (UIImage*) cachedThumbnailForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize;
+
+
+/** Asynchronously generate or load a thumbnail for a file
+
+ The file's localPath is used as the image source if present. Otherwise the file body is downloaded to a temporary location before decoding. This is a non-blocking method.
+ @param file The file the thumbnail represents
+ @param thumbSize The maximum width or height of the thumbnail, in points
+ @param completion The block called on the main thread with the thumbnail, or an error
+ */
+- (void) thumbnailForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize withCompletion:(ThumbnailCompletion)completion;
+
+
+/** Asynchronously generate or load a thumbnail for a local image
+
+ This is a non-blocking method.
+ @param filePath The path of the image to decode
+ @param thumbSize The maximum width or height of the thumbnail, in points
+ @param completion The block called on the main thread with the thumbnail, or an error
+ */
+- (void) thumbnailForPath:(NSString*)filePath ofSize:(CGFloat)thumbSize withCompletion:(ThumbnailCompletion)completion;
+
+
+/** Stop delivering a thumbnail
+
+ Should be called when a cell scrolls off screen. Completion blocks for the cancelled thumbnail will not be called, but a decode already in progress still completes so the result is cached for later.
+ @param file The file the thumbnail represents
+ @param thumbSize The size previously requested
+ */
+- (void) cancelThumbnailForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize;
+
+
+/** Remove all thumbnails from memory and disk */
+- (void) removeAllThumbnails;
+
+@end
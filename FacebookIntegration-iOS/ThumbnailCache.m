@@ -0,0 +1,309 @@
+//
+//  ThumbnailCache.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "ThumbnailCache.h"
+
+#import <CommonCrypto/CommonDigest.h>
+#import <ImageIO/ImageIO.h>
+#import <KiiSDK/Kii.h>
+
+#import "NSError+KiiErrorCode.h"
+
+@interface ThumbnailCache ()
+
+@property (nonatomic, strong) NSCache *memoryCache;
+@property (nonatomic, strong) NSOperationQueue *decodeQueue;
+@property (nonatomic, strong) NSMutableDictionary *pending;
+@property (nonatomic, strong) NSString *diskPath;
+
+@end
+
+@implementation ThumbnailCache
+
++ (ThumbnailCache*) sharedCache {
+    static ThumbnailCache *sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[ThumbnailCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _memoryCache = [[NSCache alloc] init];
+        self.memoryLimit = 16 * 1024 * 1024;
+
+        // one decode per core - decoding is CPU bound, more just thrashes
+        _decodeQueue = [[NSOperationQueue alloc] init];
+        _decodeQueue.maxConcurrentOperationCount = [[NSProcessInfo processInfo] activeProcessorCount];
+
+        _pending = [[NSMutableDictionary alloc] init];
+
+        NSString *caches = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        _diskPath = [caches stringByAppendingPathComponent:@"Thumbnails"];
+        [[NSFileManager defaultManager] createDirectoryAtPath:_diskPath
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+    }
+    return self;
+}
+
+- (void) setMemoryLimit:(NSUInteger)memoryLimit {
+    _memoryLimit = memoryLimit;
+    _memoryCache.totalCostLimit = memoryLimit;
+}
+
+#pragma mark - keys
+
+- (NSString*) keyForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize {
+
+    // include the modified date so an updated body never serves a stale thumbnail
+    NSString *identifier = (file.uuid != nil) ? file.uuid : file.localPath;
+    return [NSString stringWithFormat:@"%@-%.0f-%.0f", identifier, [file.modified timeIntervalSince1970], thumbSize];
+}
+
+- (NSString*) keyForPath:(NSString*)filePath ofSize:(CGFloat)thumbSize {
+    NSDictionary *attrs = [[NSFileManager defaultManager] attributesOfItemAtPath:filePath error:nil];
+    return [NSString stringWithFormat:@"%@-%.0f-%.0f", filePath, [[attrs fileModificationDate] timeIntervalSince1970], thumbSize];
+}
+
+- (NSString*) diskPathForKey:(NSString*)key {
+
+    const char *str = [key UTF8String];
+    unsigned char digest[CC_MD5_DIGEST_LENGTH];
+    CC_MD5(str, (CC_LONG)strlen(str), digest);
+
+    NSMutableString *name = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2 + 4];
+    for(int i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [name appendFormat:@"%02x", digest[i]];
+    }
+    [name appendString:@".png"];
+
+    return [_diskPath stringByAppendingPathComponent:name];
+}
+
+#pragma mark - decoding
+
+// Decode straight to the target size. ImageIO subsamples JPEGs while decoding,
+// so the full-resolution bitmap is never materialized.
++ (UIImage*) decodeImageAtPath:(NSString*)filePath ofSize:(CGFloat)thumbSize {
+
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)[NSURL fileURLWithPath:filePath], NULL);
+    if(source == NULL) {
+        return nil;
+    }
+
+    CGFloat scale = [[UIScreen mainScreen] scale];
+    NSDictionary *options = @{
+        (__bridge id)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+        (__bridge id)kCGImageSourceCreateThumbnailWithTransform : @YES,
+        (__bridge id)kCGImageSourceThumbnailMaxPixelSize : @(thumbSize * scale)
+    };
+
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
+
+    if(imageRef == NULL) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+
+    return image;
+}
+
+// Images loaded from disk are decoded lazily on first draw, which would land
+// on the main thread - force the decode here instead.
++ (UIImage*) decompressedImage:(UIImage*)image {
+
+    CGImageRef imageRef = image.CGImage;
+    size_t width = CGImageGetWidth(imageRef);
+    size_t height = CGImageGetHeight(imageRef);
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, width * 4, colorSpace,
+                                                 kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+    CGColorSpaceRelease(colorSpace);
+
+    if(context == NULL) {
+        return image;
+    }
+
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), imageRef);
+    CGImageRef decoded = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    UIImage *result = [UIImage imageWithCGImage:decoded scale:image.scale orientation:image.imageOrientation];
+    CGImageRelease(decoded);
+
+    return result;
+}
+
++ (NSUInteger) costForImage:(UIImage*)image {
+    return CGImageGetBytesPerRow(image.CGImage) * CGImageGetHeight(image.CGImage);
+}
+
+#pragma mark - pipeline
+
+- (UIImage*) cachedThumbnailForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize {
+    return [_memoryCache objectForKey:[self keyForFile:file ofSize:thumbSize]];
+}
+
+- (void) thumbnailForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize withCompletion:(ThumbnailCompletion)completion {
+
+    NSString *key = [self keyForFile:file ofSize:thumbSize];
+
+    [self thumbnailForKey:key ofSize:thumbSize withCompletion:completion sourceBlock:^NSString *(BOOL *temporary, NSError **error) {
+
+        if(file.localPath != nil) {
+            *temporary = FALSE;
+            return file.localPath;
+        }
+
+        NSString *tmpPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSProcessInfo processInfo] globallyUniqueString]];
+        [file getFileBodySynchronous:tmpPath withError:error];
+
+        *temporary = TRUE;
+        return (*error == nil) ? tmpPath : nil;
+    }];
+}
+
+- (void) thumbnailForPath:(NSString*)filePath ofSize:(CGFloat)thumbSize withCompletion:(ThumbnailCompletion)completion {
+
+    NSString *key = [self keyForPath:filePath ofSize:thumbSize];
+
+    [self thumbnailForKey:key ofSize:thumbSize withCompletion:completion sourceBlock:^NSString *(BOOL *temporary, NSError **error) {
+        *temporary = FALSE;
+        return filePath;
+    }];
+}
+
+- (void) thumbnailForKey:(NSString*)key
+                  ofSize:(CGFloat)thumbSize
+          withCompletion:(ThumbnailCompletion)completion
+             sourceBlock:(NSString* (^)(BOOL *temporary, NSError **error))sourceBlock {
+
+    UIImage *cached = [_memoryCache objectForKey:key];
+    if(cached != nil) {
+        if(completion != nil) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                completion(cached, nil);
+            });
+        }
+        return;
+    }
+
+    @synchronized(_pending) {
+
+        // coalesce - a decode for this key is already queued
+        NSMutableArray *waiting = [_pending objectForKey:key];
+        if(waiting != nil) {
+            if(completion != nil) {
+                [waiting addObject:[completion copy]];
+            }
+            return;
+        }
+
+        waiting = [NSMutableArray array];
+        if(completion != nil) {
+            [waiting addObject:[completion copy]];
+        }
+        [_pending setObject:waiting forKey:key];
+    }
+
+    __weak ThumbnailCache *weakSelf = self;
+    NSBlockOperation *operation = [[NSBlockOperation alloc] init];
+    __weak NSBlockOperation *weakOperation = operation;
+
+    [operation addExecutionBlock:^{
+
+        ThumbnailCache *strongSelf = weakSelf;
+        if(strongSelf == nil || weakOperation.isCancelled) {
+            return;
+        }
+
+        NSError *error = nil;
+        UIImage *thumbnail = nil;
+        NSString *diskPath = [strongSelf diskPathForKey:key];
+
+        if([[NSFileManager defaultManager] fileExistsAtPath:diskPath]) {
+            UIImage *stored = [UIImage imageWithContentsOfFile:diskPath];
+            if(stored != nil) {
+                thumbnail = [ThumbnailCache decompressedImage:[UIImage imageWithCGImage:stored.CGImage
+                                                                                  scale:[[UIScreen mainScreen] scale]
+                                                                            orientation:UIImageOrientationUp]];
+            }
+        }
+
+        if(thumbnail == nil) {
+
+            BOOL temporary = FALSE;
+            NSString *sourcePath = sourceBlock(&temporary, &error);
+
+            if(sourcePath != nil && !weakOperation.isCancelled) {
+                thumbnail = [ThumbnailCache decodeImageAtPath:sourcePath ofSize:thumbSize];
+                if(thumbnail == nil) {
+                    error = [NSError kiiErrorWithCode:KiiErrorLocalFileInvalid];
+                } else {
+                    [UIImagePNGRepresentation(thumbnail) writeToFile:diskPath atomically:YES];
+                }
+            }
+
+            if(temporary && sourcePath != nil) {
+                [[NSFileManager defaultManager] removeItemAtPath:sourcePath error:nil];
+            }
+        }
+
+        if(thumbnail != nil) {
+            [strongSelf.memoryCache setObject:thumbnail forKey:key cost:[ThumbnailCache costForImage:thumbnail]];
+        }
+
+        NSArray *completions = nil;
+        @synchronized(strongSelf.pending) {
+            completions = [strongSelf.pending objectForKey:key];
+            [strongSelf.pending removeObjectForKey:key];
+        }
+
+        if(completions.count > 0) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                for(ThumbnailCompletion block in completions) {
+                    block(thumbnail, error);
+                }
+            });
+        }
+    }];
+
+    [_decodeQueue addOperation:operation];
+}
+
+- (void) cancelThumbnailForFile:(KiiFile*)file ofSize:(CGFloat)thumbSize {
+
+    NSString *key = [self keyForFile:file ofSize:thumbSize];
+
+    // the decode itself keeps running so its result is still cached for when
+    // the cell scrolls back - only the callbacks are dropped
+    @synchronized(_pending) {
+        [[_pending objectForKey:key] removeAllObjects];
+    }
+}
+
+- (void) removeAllThumbnails {
+
+    [_memoryCache removeAllObjects];
+
+    NSFileManager *fm = [NSFileManager defaultManager];
+    for(NSString *name in [fm contentsOfDirectoryAtPath:_diskPath error:nil]) {
+        [fm removeItemAtPath:[_diskPath stringByAppendingPathComponent:name] error:nil];
+    }
+}
+
+@end
@@ -0,0 +1,93 @@
+//
+//  TokenRefresher.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+#import <KiiSDK/KiiSocialConnect.h>
+
+@class KiiUser;
+
+typedef void (^TokenValidationCompletion)(KiiUser *user, NSError *error);
+
+/** Posted on the main thread when the user has to log in again. The userInfo contains TokenRefresherExpiryKey when the social network token is about to expire, or TokenRefresherErrorKey when the server rejected the KiiUser token */
+extern NSString * const TokenRefresherNeedsReauthenticationNotification;
+
+/** The NSDate at which the social network token expires */
+extern NSString * const TokenRefresherExpiryKey;
+
+/** The NSError with which the KiiUser token was rejected */
+extern NSString * const TokenRefresherErrorKey;
+
+/** Keeps the session alive without taking the user out of the app
+
+ The SDK has no call that issues a new KiiUser token, so that token is validated rather than renewed. Every validationInterval it is authenticated again with authenticateWithTokenSynchronous:andError:, which confirms the server still accepts it and refreshes the user, and the result is saved to SessionStore. Its lifetime does not change. When the server rejects it, TokenRefresherNeedsReauthenticationNotification is posted. A check that fails for a transient reason is retried with an exponential backoff, from minimumInterval up to maxBackoff.
+
+ The social network token can only be renewed by an interactive logIn:, which switches to the Facebook app, so it is never renewed from here. Instead, leadTime before KiiSocialConnect getAccessTokenExpiresForNetwork:, less a random part of leadTime * jitter so that many devices do not ask at the same moment, TokenRefresherNeedsReauthenticationNotification is posted so the UI can ask the user to log in again. It is posted once per expiry date, and held back until the app is active. Calling start after the new login picks up the new expiry date.
+
+ Attempts are never closer together than minimumInterval. Only one validation runs at a time, and callers that need a valid token while one is in flight wait for it instead of starting their own.
+ */
+@interface TokenRefresher : NSObject
+
+/** The social network whose token expiry is watched. Defaults to kiiSCNFacebook */
+@property (nonatomic, assign) KiiSocialNetworkName network;
+
+/** How long before the social network token expires the user is asked to log in again, in seconds. Defaults to 1 hour */
+@property (nonatomic, assign) NSTimeInterval leadTime;
+
+/** The fraction of leadTime by which the request may be moved earlier at random. Defaults to 0.25 */
+@property (nonatomic, assign) double jitter;
+
+/** How often the KiiUser token is validated, in seconds. Defaults to 12 hours */
+@property (nonatomic, assign) NSTimeInterval validationInterval;
+
+/** The shortest time between two scheduled attempts, and the first retry delay, in seconds. Defaults to 1 minute */
+@property (nonatomic, assign) NSTimeInterval minimumInterval;
+
+/** The longest retry delay after repeated failures, in seconds. Defaults to 1 hour */
+@property (nonatomic, assign) NSTimeInterval maxBackoff;
+
+/** When the next scheduled check will run, nil if none is scheduled */
+@property (readonly) NSDate *scheduledCheck;
+
+/** TRUE while a validation is in flight */
+@property (readonly) BOOL validating;
+
+/** The shared token refresher
+
+ @return The process-wide TokenRefresher instance
+ */
++ (TokenRefresher*) sharedRefresher;
+
+
+/** Schedule validations for the current user and expiry checks for the network token
+
+ Call after every successful login. Safe to call again; the schedule is replaced.
+ */
+- (void) start;
+
+
+/** Cancel any scheduled check */
+- (void) stop;
+
+
+/** Validate the KiiUser token now, or join the validation already in flight
+
+ Never shows any UI. This is a non-blocking method.
+ @param completion The block called on the main thread with the validated user, or an error. May be nil
+ */
+- (void) validateWithCompletion:(TokenValidationCompletion)completion;
+
+
+/** Make sure the KiiUser token is still accepted, validating it again if the last validation failed
+
+ This is a blocking method, and must not be called on the main thread, which the validation reports back to. Doing so fails an assertion.
+ @param timeout The longest time to wait for a validation, in seconds
+ @return TRUE if the KiiUser token is valid and the social network token has not expired
+ */
+- (BOOL) waitForValidTokenWithTimeout:(NSTimeInterval)timeout;
+
+@end
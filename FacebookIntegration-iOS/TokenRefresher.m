@@ -0,0 +1,321 @@
+//
+//  TokenRefresher.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "TokenRefresher.h"
+
+#import <KiiSDK/Kii.h>
+#import <UIKit/UIKit.h>
+
+#import "NSError+KiiErrorCode.h"
+#import "SessionStore.h"
+
+NSString * const TokenRefresherNeedsReauthenticationNotification = @"TokenRefresherNeedsReauthenticationNotification";
+NSString * const TokenRefresherExpiryKey = @"TokenRefresherExpiryKey";
+NSString * const TokenRefresherErrorKey = @"TokenRefresherErrorKey";
+
+@interface TokenRefresher ()
+
+@property (strong) NSDate *scheduledCheck;
+@property (assign) BOOL validating;
+
+@property (nonatomic, strong) NSTimer *timer;
+@property (nonatomic, assign) BOOL running;
+
+// the social token expiry the UI was last told about, and one that fell due
+// while the app was in the background
+@property (nonatomic, strong) NSDate *announcedExpiry;
+@property (nonatomic, strong) NSDate *pendingExpiry;
+
+// when the user token is next due, after a success or a backoff
+@property (nonatomic, assign) NSTimeInterval nextValidation;
+@property (nonatomic, assign) NSTimeInterval lastAttempt;
+@property (nonatomic, assign) NSUInteger failures;
+@property (assign) BOOL userTokenValid;
+
+@property (nonatomic, strong) NSMutableArray *waiters;
+@property (strong) dispatch_group_t inFlight;
+
+@end
+
+@implementation TokenRefresher
+
++ (TokenRefresher*) sharedRefresher {
+    static TokenRefresher *sharedRefresher = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedRefresher = [[TokenRefresher alloc] init];
+    });
+    return sharedRefresher;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _network = kiiSCNFacebook;
+        _leadTime = 60 * 60;
+        _jitter = 0.25;
+        _validationInterval = 12 * 60 * 60;
+        _minimumInterval = 60;
+        _maxBackoff = 60 * 60;
+        _waiters = [NSMutableArray array];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidBecomeActive:)
+                                                     name:UIApplicationDidBecomeActiveNotification
+                                                   object:nil];
+    }
+    return self;
+}
+
+- (void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+#pragma mark - scheduling
+
+- (void) start {
+
+    if(![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self start];
+        });
+        return;
+    }
+
+    // called after a login, so the user token has just been issued
+    self.running = TRUE;
+    self.userTokenValid = TRUE;
+    _failures = 0;
+    _nextValidation = [NSDate timeIntervalSinceReferenceDate] + _validationInterval;
+
+    [self reschedule];
+}
+
+- (void) stop {
+    self.running = FALSE;
+    self.pendingExpiry = nil;
+    [_timer invalidate];
+    self.timer = nil;
+    self.scheduledCheck = nil;
+}
+
+// TRUE if the social token is inside its lead window and the UI has not
+// been told about this expiry date yet
+- (BOOL) expiryIsDue:(NSDate*)expires {
+
+    if(expires == nil) {
+        return FALSE;
+    }
+
+    // an expiry that has not moved forward was already announced, so it can
+    // never bring the timer back
+    if(_announcedExpiry != nil && [expires compare:_announcedExpiry] != NSOrderedDescending) {
+        return FALSE;
+    }
+
+    return [expires timeIntervalSinceNow] <= _leadTime * (1 + _jitter);
+}
+
+- (void) reschedule {
+
+    [_timer invalidate];
+    self.timer = nil;
+    self.scheduledCheck = nil;
+
+    if(!_running) {
+        return;
+    }
+
+    NSTimeInterval due = _nextValidation;
+
+    NSDate *expires = [KiiSocialConnect getAccessTokenExpiresForNetwork:_network];
+    if(expires != nil && (_announcedExpiry == nil || [expires compare:_announcedExpiry] == NSOrderedDescending)) {
+        double early = _leadTime * _jitter * ((double)arc4random_uniform(1000) / 1000.0);
+        due = MIN(due, [expires timeIntervalSinceReferenceDate] - (_leadTime + early));
+    }
+
+    if(due >= DBL_MAX) {
+        return;
+    }
+
+    // whatever the dates say, attempts are spaced at least minimumInterval
+    // apart, so an expiry stuck inside the lead window cannot spin
+    due = MAX(due, _lastAttempt + _minimumInterval);
+
+    NSDate *fireDate = [NSDate dateWithTimeIntervalSinceReferenceDate:due];
+    self.scheduledCheck = fireDate;
+    self.timer = [[NSTimer alloc] initWithFireDate:fireDate
+                                          interval:0
+                                            target:self
+                                          selector:@selector(timerFired:)
+                                          userInfo:nil
+                                           repeats:FALSE];
+    [[NSRunLoop mainRunLoop] addTimer:_timer forMode:NSRunLoopCommonModes];
+}
+
+- (void) timerFired:(NSTimer*)timer {
+
+    self.timer = nil;
+    self.scheduledCheck = nil;
+    _lastAttempt = [NSDate timeIntervalSinceReferenceDate];
+
+    NSDate *expires = [KiiSocialConnect getAccessTokenExpiresForNetwork:_network];
+    if([self expiryIsDue:expires]) {
+        [self announceExpiry:expires];
+    }
+
+    if(_lastAttempt >= _nextValidation) {
+        // reschedules once the validation finishes
+        [self validateWithCompletion:nil];
+    } else {
+        [self reschedule];
+    }
+}
+
+#pragma mark - re-authentication
+
+- (void) postReauthenticationWithUserInfo:(NSDictionary*)userInfo {
+    [[NSNotificationCenter defaultCenter] postNotificationName:TokenRefresherNeedsReauthenticationNotification
+                                                        object:self
+                                                      userInfo:userInfo];
+}
+
+- (void) announceExpiry:(NSDate*)expires {
+
+    self.announcedExpiry = expires;
+
+    // the UI can only ask the user while the app is on screen
+    if([[UIApplication sharedApplication] applicationState] != UIApplicationStateActive) {
+        self.pendingExpiry = expires;
+        return;
+    }
+
+    [self postReauthenticationWithUserInfo:@{ TokenRefresherExpiryKey : expires }];
+}
+
+- (void) applicationDidBecomeActive:(NSNotification*)notification {
+    if(_pendingExpiry != nil) {
+        NSDate *expires = _pendingExpiry;
+        self.pendingExpiry = nil;
+        [self postReauthenticationWithUserInfo:@{ TokenRefresherExpiryKey : expires }];
+    }
+}
+
+#pragma mark - validation
+
+- (void) validateWithCompletion:(TokenValidationCompletion)completion {
+
+    if(![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self validateWithCompletion:completion];
+        });
+        return;
+    }
+
+    if(completion != nil) {
+        [_waiters addObject:[completion copy]];
+    }
+
+    if(self.validating) {
+        return;
+    }
+
+    self.validating = TRUE;
+    self.inFlight = dispatch_group_create();
+    dispatch_group_enter(_inFlight);
+
+    NSString *token = [KiiUser currentUser].accessToken;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        NSError *error = nil;
+        KiiUser *user = nil;
+
+        if(token != nil) {
+            user = [KiiUser authenticateWithTokenSynchronous:token andError:&error];
+        } else {
+            error = [NSError kiiErrorWithCode:KiiErrorInvalidAccessToken];
+        }
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self userValidated:user withError:error];
+        });
+    });
+}
+
+- (NSTimeInterval) backoffForFailure:(NSUInteger)failures {
+
+    double ceiling = MIN(_maxBackoff, _minimumInterval * pow(2, failures - 1));
+
+    // half of the delay is fixed, the other half random
+    return ceiling * (0.5 + 0.5 * ((double)arc4random_uniform(1000) / 1000.0));
+}
+
+- (void) userValidated:(KiiUser*)user withError:(NSError*)error {
+
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    KiiErrorCode code = [error kiiErrorCode];
+
+    if(error == nil && user != nil) {
+
+        [[SessionStore sharedStore] saveSessionForUser:user];
+        self.userTokenValid = TRUE;
+        _failures = 0;
+        _nextValidation = now + _validationInterval;
+
+    } else if(code == KiiErrorInvalidAccessToken || code == KiiErrorUnauthorizedRequest) {
+
+        // retrying a rejected token cannot help - only a new login can
+        self.userTokenValid = FALSE;
+        _failures = 0;
+        _nextValidation = DBL_MAX;
+        [self postReauthenticationWithUserInfo:@{ TokenRefresherErrorKey : error }];
+
+    } else {
+
+        _failures++;
+        _nextValidation = now + [self backoffForFailure:_failures];
+    }
+
+    NSArray *waiters = [_waiters copy];
+    [_waiters removeAllObjects];
+
+    dispatch_group_t inFlight = self.inFlight;
+    self.inFlight = nil;
+    self.validating = FALSE;
+    dispatch_group_leave(inFlight);
+
+    for(TokenValidationCompletion waiter in waiters) {
+        waiter(user, error);
+    }
+
+    [self reschedule];
+}
+
+- (BOOL) waitForValidTokenWithTimeout:(NSTimeInterval)timeout {
+
+    NSAssert(![NSThread isMainThread], @"waitForValidTokenWithTimeout: would deadlock on the main thread");
+
+    // only validate when the last validation failed, or one is already running
+    __block dispatch_group_t inFlight = nil;
+    dispatch_sync(dispatch_get_main_queue(), ^{
+        if(!self.userTokenValid || _failures > 0) {
+            [self validateWithCompletion:nil];
+        }
+        inFlight = self.inFlight;
+    });
+
+    if(inFlight != nil) {
+        dispatch_group_wait(inFlight, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeout * NSEC_PER_SEC)));
+    }
+
+    NSDate *expires = [KiiSocialConnect getAccessTokenExpiresForNetwork:_network];
+    return self.userTokenValid && expires != nil && [expires timeIntervalSinceNow] > 0;
+}
+
+@end
@@ -0,0 +1,60 @@
+//
+//  TransferProgressGroup.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiFile;
+
+typedef void (^TransferProgressHandler)(float progress);
+typedef void (^TransferGroupCompletion)(NSArray *failedFiles, NSArray *errors);
+
+/** Aggregated, rate-limited progress for a group of KiiFile transfers
+
+ The SDK reports progress for every network chunk. A TransferProgressGroup acts as the delegate for those callbacks, folds them into a single byte-weighted progress value for the whole group, and delivers it to a typed block at most maxUpdatesPerSecond times a second. The final 100% update is never dropped.
+
+ Transfers must be started from the main thread, and all blocks are called on the main thread.
+ */
+@interface TransferProgressGroup : NSObject
+
+/** The maximum number of progress updates delivered per second. Defaults to 10 */
+@property (nonatomic, assign) double maxUpdatesPerSecond;
+
+/** The current progress of the group [0, 1], weighted by file size */
+@property (readonly) float progress;
+
+/** Called on the main thread with rate-limited group progress */
+@property (nonatomic, copy) TransferProgressHandler progressHandler;
+
+/** Called on the main thread once every transfer in the group has finished */
+@property (nonatomic, copy) TransferGroupCompletion completion;
+
+/** Create a progress group
+
+ @param progressHandler The block to deliver aggregate progress to
+ @return A new, empty TransferProgressGroup
+ */
++ (TransferProgressGroup*) groupWithProgressHandler:(TransferProgressHandler)progressHandler;
+
+
+/** Upload a file body as part of this group
+
+ Calls saveFile:withProgress:andCallback: with the group as the delegate. This is a non-blocking method.
+ @param file The file to upload. Its localPath must be set
+ */
+- (void) uploadFile:(KiiFile*)file;
+
+
+/** Download a file body as part of this group
+
+ Calls getFileBody:withDelegate:andProgress:andCallback: with the group as the delegate. This is a non-blocking method.
+ @param file The file to download
+ @param toPath The path of the file the body will be written to
+ */
+- (void) downloadFile:(KiiFile*)file toPath:(NSString*)toPath;
+
+@end
@@ -0,0 +1,170 @@
+//
+//  TransferProgressGroup.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "TransferProgressGroup.h"
+
+#import <KiiSDK/Kii.h>
+
+@interface TransferProgressGroup ()
+
+// KiiFile is not NSCopying, so files are keyed by pointer
+@property (nonatomic, strong) NSMapTable *fileProgress;
+@property (nonatomic, strong) NSMapTable *fileWeights;
+@property (nonatomic, strong) NSMutableArray *failedFiles;
+@property (nonatomic, strong) NSMutableArray *errors;
+
+@property (nonatomic, assign) double totalWeight;
+@property (nonatomic, assign) NSUInteger activeCount;
+@property (nonatomic, assign) NSTimeInterval lastDelivery;
+@property (nonatomic, assign) BOOL deliveryScheduled;
+
+// the SDK does not retain its delegate, so the group keeps itself alive
+// until its last transfer has called back
+@property (nonatomic, strong) TransferProgressGroup *keepAlive;
+
+@end
+
+@implementation TransferProgressGroup
+
++ (TransferProgressGroup*) groupWithProgressHandler:(TransferProgressHandler)progressHandler {
+    TransferProgressGroup *group = [[TransferProgressGroup alloc] init];
+    group.progressHandler = progressHandler;
+    return group;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _maxUpdatesPerSecond = 10;
+
+        NSPointerFunctionsOptions keyOptions = NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality;
+        _fileProgress = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+        _fileWeights = [NSMapTable mapTableWithKeyOptions:keyOptions valueOptions:NSPointerFunctionsStrongMemory];
+        _failedFiles = [NSMutableArray array];
+        _errors = [NSMutableArray array];
+    }
+    return self;
+}
+
+#pragma mark - starting transfers
+
+- (void) addFile:(KiiFile*)file withWeight:(long long)bytes {
+
+    // unknown sizes still count, just as a single unit
+    double weight = (bytes > 0) ? (double)bytes : 1;
+
+    [_fileWeights setObject:@(weight) forKey:file];
+    [_fileProgress setObject:@0.0f forKey:file];
+    _totalWeight += weight;
+    _activeCount++;
+    _keepAlive = self;
+}
+
+- (void) uploadFile:(KiiFile*)file {
+
+    NSDictionary *attrs = [[NSFileManager defaultManager] attributesOfItemAtPath:file.localPath error:nil];
+    [self addFile:file withWeight:[attrs fileSize]];
+
+    [file saveFile:self
+      withProgress:@selector(file:didProgress:)
+       andCallback:@selector(fileUploaded:withError:)];
+}
+
+- (void) downloadFile:(KiiFile*)file toPath:(NSString*)toPath {
+
+    [self addFile:file withWeight:[file.fileSize longLongValue]];
+
+    [file getFileBody:toPath
+         withDelegate:self
+          andProgress:@selector(file:didProgress:)
+          andCallback:@selector(fileDownloaded:toPath:withError:)];
+}
+
+#pragma mark - SDK callbacks
+
+- (void) file:(KiiFile*)file didProgress:(NSNumber*)progress {
+    [_fileProgress setObject:progress forKey:file];
+    [self deliverProgress:FALSE];
+}
+
+- (void) fileUploaded:(KiiFile*)file withError:(NSError*)error {
+    [self fileFinished:file withError:error];
+}
+
+- (void) fileDownloaded:(KiiFile*)file toPath:(NSString*)toPath withError:(NSError*)error {
+    [self fileFinished:file withError:error];
+}
+
+- (void) fileFinished:(KiiFile*)file withError:(NSError*)error {
+
+    // a failed file is still done - count it as complete so the bar finishes
+    [_fileProgress setObject:@1.0f forKey:file];
+
+    if(error != nil) {
+        [_failedFiles addObject:file];
+        [_errors addObject:error];
+    }
+
+    _activeCount--;
+    [self deliverProgress:(_activeCount == 0)];
+
+    if(_activeCount == 0) {
+        if(_completion != nil) {
+            _completion([_failedFiles copy], [_errors copy]);
+        }
+        _keepAlive = nil;
+    }
+}
+
+#pragma mark - throttling
+
+- (float) progress {
+
+    if(_totalWeight <= 0) {
+        return 0;
+    }
+
+    double done = 0;
+    for(KiiFile *file in _fileProgress) {
+        done += [[_fileProgress objectForKey:file] doubleValue] * [[_fileWeights objectForKey:file] doubleValue];
+    }
+
+    return (float)(done / _totalWeight);
+}
+
+- (void) deliverProgress:(BOOL)force {
+
+    if(_progressHandler == nil) {
+        return;
+    }
+
+    NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+    NSTimeInterval interval = (_maxUpdatesPerSecond > 0) ? 1.0 / _maxUpdatesPerSecond : 0;
+    NSTimeInterval elapsed = now - _lastDelivery;
+
+    if(force || elapsed >= interval) {
+        _lastDelivery = now;
+        _progressHandler(self.progress);
+        return;
+    }
+
+    // dropped update - make sure the latest value still goes out at the end
+    // of this interval rather than waiting for the next chunk
+    if(!_deliveryScheduled) {
+        _deliveryScheduled = TRUE;
+
+        __weak TransferProgressGroup *weakSelf = self;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)((interval - elapsed) * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            TransferProgressGroup *strongSelf = weakSelf;
+            strongSelf.deliveryScheduled = FALSE;
+            [strongSelf deliverProgress:FALSE];
+        });
+    }
+}
+
+@end
@@ -0,0 +1,95 @@
+//
+//  TransferScheduler.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiFile;
+
+typedef enum {
+    TransferPriorityLow,
+    TransferPriorityNormal,
+    TransferPriorityHigh
+} TransferPriority;
+
+typedef enum {
+    TransferDirectionUpload,
+    TransferDirectionDownload
+} TransferDirection;
+
+typedef void (^TransferCompletion)(KiiFile *file, NSError *error);
+
+/** Posted on the main thread when any scheduled transfer finishes. The object is the KiiFile, the userInfo contains TransferSchedulerWaitTimeKey, and TransferSchedulerErrorKey on failure */
+extern NSString * const TransferSchedulerDidFinishNotification;
+extern NSString * const TransferSchedulerErrorKey;
+
+/** The seconds the transfer spent queued before it started, including any rate cap delay */
+extern NSString * const TransferSchedulerWaitTimeKey;
+
+/** Queues KiiFile uploads and downloads instead of starting them all at once
+
+ Transfers run in priority order, with at most maxConcurrentTransfers in flight. An optional byte rate cap delays the start of each transfer so the average throughput stays under the limit. Rate cap start times are handed out as transfers start, highest priority first, so a high priority transfer never waits behind earlier low priority ones, and a transfer held back by the cap does not hold a transfer slot while it waits. Transfers of files that already exist on the server are persisted and can be resumed on the next launch with resumePersistedTransfers.
+ */
+@interface TransferScheduler : NSObject
+
+/** The maximum number of transfers running at once. Defaults to 2 */
+@property (nonatomic, assign) NSInteger maxConcurrentTransfers;
+
+/** The maximum average throughput, in bytes per second, across all transfers. 0 (the default) means unlimited */
+@property (nonatomic, assign) double maxBytesPerSecond;
+
+/** The number of transfers waiting for a slot or the rate cap, or in flight */
+@property (readonly) NSUInteger queueDepth;
+
+/** The bytes of completed transfers over the wall-clock time from the first start to the last finish, in bytes per second */
+@property (readonly) double throughput;
+
+/** The average time a transfer spent queued before it started, in seconds */
+@property (readonly) NSTimeInterval averageWaitTime;
+
+/** The shared transfer scheduler
+
+ @return The process-wide TransferScheduler instance
+ */
++ (TransferScheduler*) sharedScheduler;
+
+
+/** Queue a file body upload
+
+ Equivalent to saveFileSynchronous:, run when a transfer slot is free. This is a non-blocking method.
+ @param file The file to upload. Its localPath must be set
+ @param priority The priority class of the transfer
+ @param completion The block called on the main thread when the transfer finishes. May be nil
+ */
+- (void) uploadFile:(KiiFile*)file withPriority:(TransferPriority)priority andCompletion:(TransferCompletion)completion;
+
+
+/** Queue a file body download
+
+ Equivalent to getFileBodySynchronous:withError:, run when a transfer slot is free. This is a non-blocking method.
+ @param file The file to download. Must exist on the server
+ @param toPath The path of the file the body will be written to
+ @param priority The priority class of the transfer
+ @param completion The block called on the main thread when the transfer finishes. May be nil
+ */
+- (void) downloadFile:(KiiFile*)file toPath:(NSString*)toPath withPriority:(TransferPriority)priority andCompletion:(TransferCompletion)completion;
+
+
+/** Re-queue transfers that were pending when the app last exited
+
+ Should be called once on launch, after Kii has been initialized. Results are reported through TransferSchedulerDidFinishNotification.
+ */
+- (void) resumePersistedTransfers;
+
+
+/** A snapshot of the scheduler metrics
+
+ @return A dictionary with the keys queueDepth, throughput, averageWaitTime, maxWaitTime, waitTimes (the wait of each of the last 100 transfers, oldest first), completed and failed
+ */
+- (NSDictionary*) metrics;
+
+@end
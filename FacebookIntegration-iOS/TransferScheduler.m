@@ -0,0 +1,364 @@
+//
+//  TransferScheduler.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "TransferScheduler.h"
+
+#import <KiiSDK/Kii.h>
+
+NSString * const TransferSchedulerDidFinishNotification = @"TransferSchedulerDidFinishNotification";
+NSString * const TransferSchedulerErrorKey = @"TransferSchedulerErrorKey";
+NSString * const TransferSchedulerWaitTimeKey = @"TransferSchedulerWaitTimeKey";
+
+// per-transfer wait times kept for metrics
+#define TRANSFER_WAIT_SAMPLES 100
+
+@interface TransferScheduler ()
+
+@property (nonatomic, strong) NSOperationQueue *queue;
+@property (nonatomic, strong) NSMutableDictionary *persisted;
+@property (nonatomic, strong) NSString *storePath;
+
+@property (nonatomic, assign) NSUInteger completedCount;
+@property (nonatomic, assign) NSUInteger failedCount;
+@property (nonatomic, assign) long long bytesTransferred;
+@property (nonatomic, assign) NSTimeInterval firstStarted;
+@property (nonatomic, assign) NSTimeInterval lastFinished;
+@property (nonatomic, assign) NSTimeInterval totalWaitTime;
+@property (nonatomic, assign) NSTimeInterval maxWaitTime;
+@property (nonatomic, strong) NSMutableArray *waitTimes;
+@property (nonatomic, assign) NSUInteger startedCount;
+@property (nonatomic, assign) NSTimeInterval nextStartTime;
+
+// transfers not yet started, one FIFO per TransferPriority
+@property (nonatomic, strong) NSArray *pending;
+@property (nonatomic, assign) NSUInteger pendingCount;
+@property (nonatomic, assign) NSUInteger runningCount;
+@property (nonatomic, assign) BOOL wakeScheduled;
+
+@end
+
+
+/** A transfer waiting for a slot and its rate cap start time */
+@interface PendingTransfer : NSObject
+
+@property (nonatomic, strong) NSOperation *operation;
+@property (nonatomic, assign) long long bytes;
+
+@end
+
+@implementation PendingTransfer
+@end
+
+
+@implementation TransferScheduler
+
++ (TransferScheduler*) sharedScheduler {
+    static TransferScheduler *sharedScheduler = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[TransferScheduler alloc] init];
+    });
+    return sharedScheduler;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _queue = [[NSOperationQueue alloc] init];
+        _waitTimes = [NSMutableArray array];
+        _pending = @[ [NSMutableArray array], [NSMutableArray array], [NSMutableArray array] ];
+        self.maxConcurrentTransfers = 2;
+
+        NSString *support = [NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES) objectAtIndex:0];
+        [[NSFileManager defaultManager] createDirectoryAtPath:support
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        _storePath = [support stringByAppendingPathComponent:@"PendingTransfers.plist"];
+
+        _persisted = [NSMutableDictionary dictionaryWithContentsOfFile:_storePath];
+        if(_persisted == nil) {
+            _persisted = [NSMutableDictionary dictionary];
+        }
+    }
+    return self;
+}
+
+- (void) setMaxConcurrentTransfers:(NSInteger)maxConcurrentTransfers {
+    @synchronized(self) {
+        _maxConcurrentTransfers = maxConcurrentTransfers;
+        _queue.maxConcurrentOperationCount = maxConcurrentTransfers;
+    }
+    [self startPending];
+}
+
+- (void) setMaxBytesPerSecond:(double)maxBytesPerSecond {
+    @synchronized(self) {
+        _maxBytesPerSecond = maxBytesPerSecond;
+    }
+    [self startPending];
+}
+
+#pragma mark - persistence
+
+- (void) persistTransfer:(NSDictionary*)transfer withID:(NSString*)transferID {
+    @synchronized(_persisted) {
+        [_persisted setObject:transfer forKey:transferID];
+        [_persisted writeToFile:_storePath atomically:YES];
+    }
+}
+
+- (void) forgetTransferWithID:(NSString*)transferID {
+    @synchronized(_persisted) {
+        [_persisted removeObjectForKey:transferID];
+        [_persisted writeToFile:_storePath atomically:YES];
+    }
+}
+
+- (void) resumePersistedTransfers {
+
+    NSDictionary *pending = nil;
+    @synchronized(_persisted) {
+        pending = [_persisted copy];
+        [_persisted removeAllObjects];
+    }
+
+    for(NSDictionary *transfer in [pending allValues]) {
+
+        KiiFile *file = [KiiFile fileWithURI:[transfer objectForKey:@"uri"]];
+        TransferPriority priority = [[transfer objectForKey:@"priority"] intValue];
+
+        if([[transfer objectForKey:@"direction"] intValue] == TransferDirectionUpload) {
+            file.localPath = [transfer objectForKey:@"path"];
+            [self uploadFile:file withPriority:priority andCompletion:nil];
+        } else {
+            [self downloadFile:file toPath:[transfer objectForKey:@"path"] withPriority:priority andCompletion:nil];
+        }
+    }
+}
+
+#pragma mark - scheduling
+
++ (NSOperationQueuePriority) queuePriorityFor:(TransferPriority)priority {
+    switch(priority) {
+        case TransferPriorityHigh:  return NSOperationQueuePriorityHigh;
+        case TransferPriorityLow:   return NSOperationQueuePriorityLow;
+        default:                    return NSOperationQueuePriorityNormal;
+    }
+}
+
+// Start as many pending transfers as there are free slots, highest priority
+// first. The SDK owns the sockets, so the rate cap is applied by spacing out
+// transfer starts, and each start time is taken only when the transfer starts,
+// so a high priority transfer never waits behind a low priority reservation.
+- (void) startPending {
+
+    NSMutableArray *starting = [NSMutableArray array];
+
+    @synchronized(self) {
+
+        NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+
+        while(_pendingCount > 0 && _runningCount < MAX(_maxConcurrentTransfers, 1)) {
+
+            if(_maxBytesPerSecond > 0 && now < _nextStartTime) {
+
+                // nothing finishing may be due before the cap allows the next
+                // start, so wake up for it
+                if(!_wakeScheduled) {
+                    _wakeScheduled = TRUE;
+                    __weak TransferScheduler *weakSelf = self;
+                    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)((_nextStartTime - now) * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                        TransferScheduler *strongSelf = weakSelf;
+                        @synchronized(strongSelf) {
+                            strongSelf.wakeScheduled = FALSE;
+                        }
+                        [strongSelf startPending];
+                    });
+                }
+                break;
+            }
+
+            PendingTransfer *next = nil;
+            for(NSInteger priority = TransferPriorityHigh; priority >= TransferPriorityLow && next == nil; priority--) {
+                NSMutableArray *fifo = [_pending objectAtIndex:priority];
+                if(fifo.count > 0) {
+                    next = [fifo objectAtIndex:0];
+                    [fifo removeObjectAtIndex:0];
+                }
+            }
+
+            _pendingCount--;
+            _runningCount++;
+
+            if(_maxBytesPerSecond > 0) {
+                _nextStartTime = MAX(now, _nextStartTime) + (double)next.bytes / _maxBytesPerSecond;
+            }
+
+            [starting addObject:next.operation];
+        }
+    }
+
+    for(NSOperation *operation in starting) {
+        [_queue addOperation:operation];
+    }
+}
+
+- (void) uploadFile:(KiiFile*)file withPriority:(TransferPriority)priority andCompletion:(TransferCompletion)completion {
+
+    NSDictionary *attrs = [[NSFileManager defaultManager] attributesOfItemAtPath:file.localPath error:nil];
+    long long bytes = [attrs fileSize];
+
+    [self scheduleFile:file
+             direction:TransferDirectionUpload
+                  path:file.localPath
+                 bytes:bytes
+              priority:priority
+            completion:completion
+                 block:^(NSError **error) {
+                     [file saveFileSynchronous:error];
+                 }];
+}
+
+- (void) downloadFile:(KiiFile*)file toPath:(NSString*)toPath withPriority:(TransferPriority)priority andCompletion:(TransferCompletion)completion {
+
+    [self scheduleFile:file
+             direction:TransferDirectionDownload
+                  path:toPath
+                 bytes:[file.fileSize longLongValue]
+              priority:priority
+            completion:completion
+                 block:^(NSError **error) {
+                     [file getFileBodySynchronous:toPath withError:error];
+                 }];
+}
+
+- (void) scheduleFile:(KiiFile*)file
+            direction:(TransferDirection)direction
+                 path:(NSString*)path
+                bytes:(long long)bytes
+             priority:(TransferPriority)priority
+           completion:(TransferCompletion)completion
+                block:(void (^)(NSError **error))block {
+
+    NSString *transferID = [[NSProcessInfo processInfo] globallyUniqueString];
+
+    // new files have no URI to restore them from, so only existing ones persist
+    if(file.objectURI != nil && path != nil) {
+        [self persistTransfer:@{ @"uri" : file.objectURI,
+                                 @"path" : path,
+                                 @"direction" : @(direction),
+                                 @"priority" : @(priority) }
+                       withID:transferID];
+    }
+
+    NSTimeInterval enqueued = [NSDate timeIntervalSinceReferenceDate];
+    __weak TransferScheduler *weakSelf = self;
+
+    NSBlockOperation *operation = [NSBlockOperation blockOperationWithBlock:^{
+
+        TransferScheduler *strongSelf = weakSelf;
+
+        NSTimeInterval began = [NSDate timeIntervalSinceReferenceDate];
+        NSError *error = nil;
+        block(&error);
+        NSTimeInterval finished = [NSDate timeIntervalSinceReferenceDate];
+        NSTimeInterval waited = began - enqueued;
+
+        @synchronized(strongSelf) {
+            if(strongSelf.startedCount == 0 || began < strongSelf.firstStarted) {
+                strongSelf.firstStarted = began;
+            }
+            strongSelf.lastFinished = MAX(strongSelf.lastFinished, finished);
+            strongSelf.startedCount++;
+            strongSelf.totalWaitTime += waited;
+            strongSelf.maxWaitTime = MAX(strongSelf.maxWaitTime, waited);
+            [strongSelf.waitTimes addObject:@(waited)];
+            if(strongSelf.waitTimes.count > TRANSFER_WAIT_SAMPLES) {
+                [strongSelf.waitTimes removeObjectAtIndex:0];
+            }
+            if(error == nil) {
+                strongSelf.completedCount++;
+                strongSelf.bytesTransferred += bytes;
+            } else {
+                strongSelf.failedCount++;
+            }
+            strongSelf.runningCount--;
+        }
+
+        [strongSelf forgetTransferWithID:transferID];
+        [strongSelf startPending];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+
+            if(completion != nil) {
+                completion(file, error);
+            }
+
+            NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:@(waited) forKey:TransferSchedulerWaitTimeKey];
+            if(error != nil) {
+                [userInfo setObject:error forKey:TransferSchedulerErrorKey];
+            }
+            [[NSNotificationCenter defaultCenter] postNotificationName:TransferSchedulerDidFinishNotification
+                                                                object:file
+                                                              userInfo:userInfo];
+        });
+    }];
+
+    operation.queuePriority = [TransferScheduler queuePriorityFor:priority];
+
+    // transfers wait here rather than in the queue, so a transfer held back
+    // by the rate cap never sits on one of the maxConcurrentTransfers slots
+    PendingTransfer *transfer = [[PendingTransfer alloc] init];
+    transfer.operation = operation;
+    transfer.bytes = bytes;
+
+    @synchronized(self) {
+        [[_pending objectAtIndex:MIN(MAX(priority, TransferPriorityLow), TransferPriorityHigh)] addObject:transfer];
+        _pendingCount++;
+    }
+
+    [self startPending];
+}
+
+#pragma mark - metrics
+
+- (NSUInteger) queueDepth {
+    @synchronized(self) {
+        return _pendingCount + _runningCount;
+    }
+}
+
+- (double) throughput {
+    @synchronized(self) {
+        // wall-clock time from the first start to the last finish, so
+        // overlapping transfers are not counted twice
+        NSTimeInterval elapsed = _lastFinished - _firstStarted;
+        return (_startedCount > 0 && elapsed > 0) ? _bytesTransferred / elapsed : 0;
+    }
+}
+
+- (NSTimeInterval) averageWaitTime {
+    @synchronized(self) {
+        return (_startedCount > 0) ? _totalWaitTime / _startedCount : 0;
+    }
+}
+
+- (NSDictionary*) metrics {
+    @synchronized(self) {
+        return @{ @"queueDepth" : @(self.queueDepth),
+                  @"throughput" : @(self.throughput),
+                  @"averageWaitTime" : @(self.averageWaitTime),
+                  @"maxWaitTime" : @(_maxWaitTime),
+                  @"waitTimes" : [_waitTimes copy],
+                  @"completed" : @(_completedCount),
+                  @"failed" : @(_failedCount) };
+    }
+}
+
+@end
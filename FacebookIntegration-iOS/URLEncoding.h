@@ -0,0 +1,76 @@
+//
+//  URLEncoding.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/** Table-driven percent-encoding for request paths and query strings
+
+ Everything outside the RFC 3986 unreserved set (letters, digits and -._~) is escaped as %XX over UTF-8. Paths are encoded the same way, except that '/' is left as a separator. Most keys and values need no escaping at all, so encodeString: first scans the string against a lookup table and returns the same instance, without allocating, when nothing has to change.
+ */
+@interface URLEncoding : NSObject
+
+/** Percent-encode a string as UTF-8
+
+ @param string The string to encode
+ @return The encoded string, or string itself if nothing needed escaping
+ */
++ (NSString*) encodeString:(NSString*)string;
+
+
+/** Percent-encode a path as UTF-8, leaving '/' unescaped
+
+ @param path The path to encode, such as "buckets/my bucket/objects"
+ @return The encoded path, or path itself if nothing needed escaping
+ */
++ (NSString*) encodePath:(NSString*)path;
+
+
+/** Percent-encode a UTF-8 buffer into a caller-provided buffer
+
+ Nothing is written past capacity. Call with a NULL buffer to find the required size.
+ @param bytes The UTF-8 bytes to encode
+ @param length The number of bytes
+ @param buffer The output buffer. May be NULL
+ @param capacity The size of buffer in bytes
+ @return The length of the full encoded output. If this is larger than capacity, the output was truncated
+ */
++ (size_t) encodeBytes:(const char*)bytes length:(size_t)length intoBuffer:(char*)buffer capacity:(size_t)capacity;
+
+
+/** Percent-encode a UTF-8 path buffer into a caller-provided buffer, leaving '/' unescaped
+
+ Nothing is written past capacity. Call with a NULL buffer to find the required size.
+ @param bytes The UTF-8 bytes to encode
+ @param length The number of bytes
+ @param buffer The output buffer. May be NULL
+ @param capacity The size of buffer in bytes
+ @return The length of the full encoded output. If this is larger than capacity, the output was truncated
+ */
++ (size_t) encodePathBytes:(const char*)bytes length:(size_t)length intoBuffer:(char*)buffer capacity:(size_t)capacity;
+
+
+/** Decode a percent-encoded string
+
+ '+' is decoded as a space, as in form-encoded query strings.
+ @param string The string to decode
+ @return The decoded string, string itself if it contained no escapes, or nil if the escapes are not valid UTF-8
+ */
++ (NSString*) decodeString:(NSString*)string;
+
+
+/** Decode a percent-encoded buffer into a caller-provided buffer
+
+ The output is never longer than the input, so a buffer of length bytes is always enough. Malformed escapes are copied through unchanged.
+ @param bytes The encoded bytes
+ @param length The number of bytes
+ @param buffer The output buffer, at least length bytes
+ @return The number of bytes written
+ */
++ (size_t) decodeBytes:(const char*)bytes length:(size_t)length intoBuffer:(char*)buffer;
+
+@end
@@ -0,0 +1,196 @@
+//
+//  URLEncoding.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "URLEncoding.h"
+
+// strings up to this many UTF-8 bytes are encoded on the stack
+#define URL_STACK_BUFFER 1024
+
+// bits set for the bytes that pass through untouched: the RFC 3986
+// unreserved characters everywhere, and '/' in paths as well
+#define URL_SAFE_COMPONENT  0x01
+#define URL_SAFE_PATH       0x02
+#define URL_SAFE_ANY        (URL_SAFE_COMPONENT | URL_SAFE_PATH)
+
+static const unsigned char kSafe[256] = {
+    ['0'] = URL_SAFE_ANY, ['1'] = URL_SAFE_ANY, ['2'] = URL_SAFE_ANY, ['3'] = URL_SAFE_ANY, ['4'] = URL_SAFE_ANY,
+    ['5'] = URL_SAFE_ANY, ['6'] = URL_SAFE_ANY, ['7'] = URL_SAFE_ANY, ['8'] = URL_SAFE_ANY, ['9'] = URL_SAFE_ANY,
+    ['A'] = URL_SAFE_ANY, ['B'] = URL_SAFE_ANY, ['C'] = URL_SAFE_ANY, ['D'] = URL_SAFE_ANY, ['E'] = URL_SAFE_ANY, ['F'] = URL_SAFE_ANY, ['G'] = URL_SAFE_ANY,
+    ['H'] = URL_SAFE_ANY, ['I'] = URL_SAFE_ANY, ['J'] = URL_SAFE_ANY, ['K'] = URL_SAFE_ANY, ['L'] = URL_SAFE_ANY, ['M'] = URL_SAFE_ANY, ['N'] = URL_SAFE_ANY,
+    ['O'] = URL_SAFE_ANY, ['P'] = URL_SAFE_ANY, ['Q'] = URL_SAFE_ANY, ['R'] = URL_SAFE_ANY, ['S'] = URL_SAFE_ANY, ['T'] = URL_SAFE_ANY, ['U'] = URL_SAFE_ANY,
+    ['V'] = URL_SAFE_ANY, ['W'] = URL_SAFE_ANY, ['X'] = URL_SAFE_ANY, ['Y'] = URL_SAFE_ANY, ['Z'] = URL_SAFE_ANY,
+    ['a'] = URL_SAFE_ANY, ['b'] = URL_SAFE_ANY, ['c'] = URL_SAFE_ANY, ['d'] = URL_SAFE_ANY, ['e'] = URL_SAFE_ANY, ['f'] = URL_SAFE_ANY, ['g'] = URL_SAFE_ANY,
+    ['h'] = URL_SAFE_ANY, ['i'] = URL_SAFE_ANY, ['j'] = URL_SAFE_ANY, ['k'] = URL_SAFE_ANY, ['l'] = URL_SAFE_ANY, ['m'] = URL_SAFE_ANY, ['n'] = URL_SAFE_ANY,
+    ['o'] = URL_SAFE_ANY, ['p'] = URL_SAFE_ANY, ['q'] = URL_SAFE_ANY, ['r'] = URL_SAFE_ANY, ['s'] = URL_SAFE_ANY, ['t'] = URL_SAFE_ANY, ['u'] = URL_SAFE_ANY,
+    ['v'] = URL_SAFE_ANY, ['w'] = URL_SAFE_ANY, ['x'] = URL_SAFE_ANY, ['y'] = URL_SAFE_ANY, ['z'] = URL_SAFE_ANY,
+    ['-'] = URL_SAFE_ANY, ['.'] = URL_SAFE_ANY, ['_'] = URL_SAFE_ANY, ['~'] = URL_SAFE_ANY,
+    ['/'] = URL_SAFE_PATH
+};
+
+static const char kHexDigits[] = "0123456789ABCDEF";
+
+static inline int hexValue(unsigned char c) {
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// returns the offset of the first byte that needs escaping, or length
+static inline size_t firstReserved(const unsigned char *bytes, size_t length, unsigned char safe) {
+    size_t i = 0;
+    for(; i + 4 <= length; i += 4) {
+        if(!(kSafe[bytes[i]] & kSafe[bytes[i + 1]] & kSafe[bytes[i + 2]] & kSafe[bytes[i + 3]] & safe)) {
+            break;
+        }
+    }
+    while(i < length && (kSafe[bytes[i]] & safe)) {
+        i++;
+    }
+    return i;
+}
+
+static size_t encodeBytes(const char *bytes, size_t length, char *buffer, size_t capacity, unsigned char safe) {
+
+    const unsigned char *in = (const unsigned char*)bytes;
+    size_t out = 0;
+
+    for(size_t i = 0; i < length; i++) {
+        unsigned char c = in[i];
+        if(kSafe[c] & safe) {
+            if(buffer != NULL && out < capacity) {
+                buffer[out] = c;
+            }
+            out++;
+        } else {
+            if(buffer != NULL && out + 3 <= capacity) {
+                buffer[out] = '%';
+                buffer[out + 1] = kHexDigits[c >> 4];
+                buffer[out + 2] = kHexDigits[c & 0x0f];
+            }
+            out += 3;
+        }
+    }
+
+    return out;
+}
+
+@implementation URLEncoding
+
+#pragma mark - encoding
+
++ (size_t) encodeBytes:(const char*)bytes length:(size_t)length intoBuffer:(char*)buffer capacity:(size_t)capacity {
+    return encodeBytes(bytes, length, buffer, capacity, URL_SAFE_COMPONENT);
+}
+
++ (size_t) encodePathBytes:(const char*)bytes length:(size_t)length intoBuffer:(char*)buffer capacity:(size_t)capacity {
+    return encodeBytes(bytes, length, buffer, capacity, URL_SAFE_PATH);
+}
+
++ (NSString*) encodeString:(NSString*)string safe:(unsigned char)safe {
+
+    if(string.length == 0) {
+        return string;
+    }
+
+    // every path takes its length from the string, never from a NUL, so an
+    // embedded NUL is escaped instead of ending the string early
+    CFStringRef cf = (__bridge CFStringRef)string;
+    CFIndex characters = CFStringGetLength(cf);
+
+    UInt8 stack[URL_STACK_BUFFER];
+    const char *bytes = CFStringGetCStringPtr(cf, kCFStringEncodingASCII);
+    size_t length = 0;
+    NSData *data = nil;
+
+    if(bytes != NULL) {
+        // ASCII backed strings expose their bytes directly, one per character
+        length = characters;
+    } else {
+        CFIndex used = 0;
+        CFIndex converted = CFStringGetBytes(cf, CFRangeMake(0, characters), kCFStringEncodingUTF8, 0, false, stack, sizeof(stack), &used);
+        if(converted == characters) {
+            bytes = (const char*)stack;
+            length = used;
+        } else {
+            data = [string dataUsingEncoding:NSUTF8StringEncoding];
+            bytes = data.bytes;
+            length = data.length;
+        }
+    }
+
+    size_t clean = firstReserved((const unsigned char*)bytes, length, safe);
+    if(clean == length) {
+        return string;
+    }
+
+    // the clean prefix is copied once, the rest goes through the table
+    size_t needed = clean + encodeBytes(bytes + clean, length - clean, NULL, 0, safe);
+    char *output = malloc(needed);
+    memcpy(output, bytes, clean);
+    encodeBytes(bytes + clean, length - clean, output + clean, needed - clean, safe);
+
+    return [[NSString alloc] initWithBytesNoCopy:output length:needed encoding:NSASCIIStringEncoding freeWhenDone:YES];
+}
+
++ (NSString*) encodeString:(NSString*)string {
+    return [URLEncoding encodeString:string safe:URL_SAFE_COMPONENT];
+}
+
++ (NSString*) encodePath:(NSString*)path {
+    return [URLEncoding encodeString:path safe:URL_SAFE_PATH];
+}
+
+#pragma mark - decoding
+
++ (size_t) decodeBytes:(const char*)bytes length:(size_t)length intoBuffer:(char*)buffer {
+
+    const unsigned char *in = (const unsigned char*)bytes;
+    size_t out = 0;
+
+    for(size_t i = 0; i < length; i++) {
+        unsigned char c = in[i];
+        if(c == '%' && i + 2 < length && hexValue(in[i + 1]) >= 0 && hexValue(in[i + 2]) >= 0) {
+            buffer[out++] = (char)((hexValue(in[i + 1]) << 4) | hexValue(in[i + 2]));
+            i += 2;
+        } else if(c == '+') {
+            buffer[out++] = ' ';
+        } else {
+            buffer[out++] = c;
+        }
+    }
+
+    return out;
+}
+
++ (NSString*) decodeString:(NSString*)string {
+
+    static NSCharacterSet *escapes = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        escapes = [NSCharacterSet characterSetWithCharactersInString:@"%+"];
+    });
+
+    if([string rangeOfCharacterFromSet:escapes].location == NSNotFound) {
+        return string;
+    }
+
+    NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+    char *output = malloc(data.length);
+    size_t length = [URLEncoding decodeBytes:data.bytes length:data.length intoBuffer:output];
+
+    NSString *decoded = [[NSString alloc] initWithBytesNoCopy:output length:length encoding:NSUTF8StringEncoding freeWhenDone:YES];
+    if(decoded == nil) {
+        // not freed by NSString when the bytes fail to decode
+        free(output);
+    }
+
+    return decoded;
+}
+
+@end
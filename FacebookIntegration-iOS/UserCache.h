@@ -0,0 +1,84 @@
+//
+//  UserCache.h
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+@class KiiUser;
+
+typedef void (^UserCacheCompletion)(NSArray *users, NSDictionary *errors);
+
+/** Process-wide cache of refreshed KiiUser objects, keyed by objectURI
+
+ Users are kept for timeToLive after they were refreshed, and at most maxUsers are held. Concurrent requests for the same user share a single refreshSynchronous: call. refreshUsers: fills a whole member list at once, refreshing only the users that are missing or stale, several at a time.
+ */
+@interface UserCache : NSObject
+
+/** How long a refreshed user is served from the cache, in seconds. Defaults to 10 minutes */
+@property (nonatomic, assign) NSTimeInterval timeToLive;
+
+/** The maximum number of users held. Defaults to 500 */
+@property (nonatomic, assign) NSUInteger maxUsers;
+
+/** The maximum number of refreshes in flight during refreshUsers:. Defaults to 4 */
+@property (nonatomic, assign) NSUInteger concurrency;
+
+/** The shared user cache
+
+ @return The process-wide UserCache instance
+ */
++ (UserCache*) sharedCache;
+
+
+/** Get a cached user without touching the network
+
+ @param uri The objectURI of the user
+ @return The user, nil if not cached or stale
+ */
+- (KiiUser*) cachedUserWithURI:(NSString*)uri;
+
+
+/** Get a refreshed user, from the cache if possible
+
+ If another thread is already refreshing the same user, this waits for that refresh instead of starting a new one. This is a blocking method.
+ @param uri The objectURI of the user
+ @param error An NSError object, set to nil, to test for errors. invalidURI if uri is nil or empty
+ @return The refreshed user, nil on failure
+ */
+- (KiiUser*) userWithURI:(NSString*)uri andError:(NSError**)error;
+
+
+/** Refresh a list of users, such as the result of getMemberListSynchronous:
+
+ This is a blocking method.
+ @param users An array of KiiUser objects with a valid objectURI
+ @param errors Set to a dictionary of NSError objects keyed by the objectURI of each user that failed to refresh, nil if all succeeded
+ @return An array of refreshed users in the same order. Users that failed to refresh are returned as given
+ */
+- (NSArray*) refreshUsers:(NSArray*)users withErrors:(NSDictionary**)errors;
+
+
+/** Refresh a list of users, such as the result of getMemberListSynchronous:
+
+ This is a non-blocking method.
+ @param users An array of KiiUser objects with a valid objectURI
+ @param completion The block called on the main thread with the refreshed users and any errors keyed by objectURI
+ */
+- (void) refreshUsers:(NSArray*)users withCompletion:(UserCacheCompletion)completion;
+
+
+/** Drop a user from the cache, for example after it was saved
+
+ @param uri The objectURI of the user
+ */
+- (void) invalidateUserWithURI:(NSString*)uri;
+
+
+/** Drop every cached user */
+- (void) removeAllUsers;
+
+@end
@@ -0,0 +1,232 @@
+//
+//  UserCache.m
+//  FacebookIntegration-iOS
+//
+//  Created by Kii on 10/18/26.
+//  Copyright (c) 2026 Kii. All rights reserved.
+//
+
+#import "UserCache.h"
+
+#import <KiiSDK/Kii.h>
+
+#import "NSError+KiiErrorCode.h"
+
+/** A cached user and when it was refreshed */
+@interface UserCacheEntry : NSObject
+
+@property (nonatomic, strong) KiiUser *user;
+@property (nonatomic, assign) NSTimeInterval refreshedAt;
+
+@end
+
+@implementation UserCacheEntry
+@end
+
+
+/** A refresh in flight, shared by every caller asking for the same user */
+@interface UserCacheRefresh : NSObject
+
+@property (nonatomic, strong) dispatch_group_t group;
+@property (nonatomic, strong) KiiUser *user;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation UserCacheRefresh
+@end
+
+
+@interface UserCache ()
+
+@property (nonatomic, strong) NSCache *users;
+@property (nonatomic, strong) NSMutableDictionary *inFlight;
+
+@end
+
+@implementation UserCache
+
++ (UserCache*) sharedCache {
+    static UserCache *sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[UserCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (id) init {
+    self = [super init];
+    if(self) {
+        _timeToLive = 10 * 60;
+        _concurrency = 4;
+        _users = [[NSCache alloc] init];
+        _inFlight = [NSMutableDictionary dictionary];
+        self.maxUsers = 500;
+    }
+    return self;
+}
+
+- (void) setMaxUsers:(NSUInteger)maxUsers {
+    _maxUsers = maxUsers;
+    _users.countLimit = maxUsers;
+}
+
+#pragma mark - lookups
+
+- (KiiUser*) cachedUserWithURI:(NSString*)uri {
+
+    if(uri == nil) {
+        return nil;
+    }
+
+    UserCacheEntry *entry = [_users objectForKey:uri];
+    if(entry == nil || [NSDate timeIntervalSinceReferenceDate] - entry.refreshedAt > _timeToLive) {
+        return nil;
+    }
+
+    return entry.user;
+}
+
+- (KiiUser*) userWithURI:(NSString*)uri andError:(NSError**)error {
+
+    // nil can not be a dictionary key, and no user lives at an empty URI
+    if(uri.length == 0) {
+        if(error != NULL) {
+            *error = [NSError kiiErrorWithCode:KiiErrorInvalidURI];
+        }
+        return nil;
+    }
+
+    KiiUser *cached = [self cachedUserWithURI:uri];
+    if(cached != nil) {
+        if(error != NULL) {
+            *error = nil;
+        }
+        return cached;
+    }
+
+    UserCacheRefresh *refresh = nil;
+    BOOL owner = FALSE;
+
+    @synchronized(_inFlight) {
+        refresh = [_inFlight objectForKey:uri];
+        if(refresh == nil) {
+            refresh = [[UserCacheRefresh alloc] init];
+            refresh.group = dispatch_group_create();
+            dispatch_group_enter(refresh.group);
+            [_inFlight setObject:refresh forKey:uri];
+            owner = TRUE;
+        }
+    }
+
+    if(owner) {
+
+        NSError *refreshError = nil;
+        KiiUser *user = [KiiUser userWithURI:uri];
+        [user refreshSynchronous:&refreshError];
+
+        if(refreshError == nil) {
+            UserCacheEntry *entry = [[UserCacheEntry alloc] init];
+            entry.user = user;
+            entry.refreshedAt = [NSDate timeIntervalSinceReferenceDate];
+            [_users setObject:entry forKey:uri];
+            refresh.user = user;
+        }
+        refresh.error = refreshError;
+
+        @synchronized(_inFlight) {
+            [_inFlight removeObjectForKey:uri];
+        }
+        dispatch_group_leave(refresh.group);
+
+    } else {
+        dispatch_group_wait(refresh.group, DISPATCH_TIME_FOREVER);
+    }
+
+    if(error != NULL) {
+        *error = refresh.error;
+    }
+
+    return refresh.user;
+}
+
+#pragma mark - multi-get
+
+- (NSArray*) refreshUsers:(NSArray*)users withErrors:(NSDictionary**)errors {
+
+    NSMutableArray *refreshed = [users mutableCopy];
+    NSMutableDictionary *failures = [NSMutableDictionary dictionary];
+
+    // serve what we can from the cache, and only refresh the rest
+    NSMutableIndexSet *missing = [NSMutableIndexSet indexSet];
+    [users enumerateObjectsUsingBlock:^(KiiUser *user, NSUInteger idx, BOOL *stop) {
+        KiiUser *cached = [self cachedUserWithURI:user.objectURI];
+        if(cached != nil) {
+            [refreshed replaceObjectAtIndex:idx withObject:cached];
+        } else if(user.objectURI != nil) {
+            [missing addIndex:idx];
+        }
+    }];
+
+    dispatch_semaphore_t slots = dispatch_semaphore_create(MAX(_concurrency, 1));
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+
+    [missing enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+
+        NSString *uri = [[users objectAtIndex:idx] objectURI];
+        dispatch_semaphore_wait(slots, DISPATCH_TIME_FOREVER);
+
+        dispatch_group_async(group, queue, ^{
+
+            NSError *error = nil;
+            KiiUser *user = [self userWithURI:uri andError:&error];
+
+            @synchronized(refreshed) {
+                if(user != nil) {
+                    [refreshed replaceObjectAtIndex:idx withObject:user];
+                } else if(error != nil) {
+                    [failures setObject:error forKey:uri];
+                }
+            }
+
+            dispatch_semaphore_signal(slots);
+        });
+    }];
+
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    if(errors != NULL) {
+        *errors = (failures.count > 0) ? failures : nil;
+    }
+
+    return refreshed;
+}
+
+- (void) refreshUsers:(NSArray*)users withCompletion:(UserCacheCompletion)completion {
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+
+        NSDictionary *errors = nil;
+        NSArray *refreshed = [self refreshUsers:users withErrors:&errors];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(refreshed, errors);
+        });
+    });
+}
+
+#pragma mark - invalidation
+
+- (void) invalidateUserWithURI:(NSString*)uri {
+    if(uri != nil) {
+        [_users removeObjectForKey:uri];
+    }
+}
+
+- (void) removeAllUsers {
+    [_users removeAllObjects];
+}
+
+@end
@@ -10,26 +10,139 @@
 
 #import <KiiSDK/Kii.h>
 
+#import "Benchmarks.h"
+#import "LoginPrefetcher.h"
+#import "LoginTrace.h"
+#import "SessionStore.h"
+#import "TokenRefresher.h"
+
+@interface ViewController () <UIAlertViewDelegate, LoginTraceSink>
+
+@property (nonatomic, strong) UILabel *traceLabel;
+
+@end
+
 @implementation ViewController
 
+- (void) viewDidLoad {
+    [super viewDidLoad];
+    
+    // the per-phase timings of the last login, below the login button
+    CGRect bounds = self.view.bounds;
+    _traceLabel = [[UILabel alloc] initWithFrame:CGRectMake(20, 310, bounds.size.width - 40, bounds.size.height - 330)];
+    _traceLabel.autoresizingMask = UIViewAutoresizingFlexibleWidth;
+    _traceLabel.backgroundColor = [UIColor clearColor];
+    _traceLabel.font = [UIFont fontWithName:@"Courier" size:12];
+    _traceLabel.numberOfLines = 0;
+    [self.view addSubview:_traceLabel];
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(needsReauthentication:)
+                                                 name:TokenRefresherNeedsReauthenticationNotification
+                                               object:nil];
+}
+
+- (void) dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void) viewWillAppear:(BOOL)animated {
+    [super viewWillAppear:animated];
+    
+    // sinks are held strongly, so only while on screen
+    [[LoginTrace sharedTrace] addSink:self];
+}
+
+- (void) viewDidDisappear:(BOOL)animated {
+    [super viewDidDisappear:animated];
+    
+    [[LoginTrace sharedTrace] removeSink:self];
+}
+
+- (void) loginTrace:(LoginTrace*)trace didFinishWithSpans:(NSArray*)spans andError:(NSError*)error {
+    
+    NSMutableString *breakdown = [NSMutableString stringWithString:(error != nil) ? @"Login failed" : @"Login"];
+    for(LoginTraceSpan *span in spans) {
+        [breakdown appendFormat:@"\n%-10s %7.3fs", [span.name UTF8String], span.duration];
+    }
+    
+    _traceLabel.text = breakdown;
+    
+    // top-align the text in the space under the button
+    CGRect frame = _traceLabel.frame;
+    CGSize size = [breakdown sizeWithFont:_traceLabel.font
+                        constrainedToSize:CGSizeMake(frame.size.width, CGFLOAT_MAX)
+                            lineBreakMode:NSLineBreakByWordWrapping];
+    frame.size.height = MIN(size.height, self.view.bounds.size.height - frame.origin.y);
+    _traceLabel.frame = frame;
+}
+
+- (void) needsReauthentication:(NSNotification*)notification {
+    
+    // logging in switches to Facebook, so only the user may start it
+    UIAlertView *alert = [[UIAlertView alloc] initWithTitle:@"Session expiring"
+                                                    message:@"Please log in again to stay connected."
+                                                   delegate:self
+                                          cancelButtonTitle:@"Later"
+                                          otherButtonTitles:@"Log In", nil];
+    [alert show];
+}
+
+- (void) alertView:(UIAlertView*)alertView clickedButtonAtIndex:(NSInteger)buttonIndex {
+    if(buttonIndex != alertView.cancelButtonIndex) {
+        [self logIn:nil];
+    }
+}
+
 - (void) userLoggedIn:(KiiUser*)user
             toNetwork:(KiiSocialNetworkName)network
             withError:(KiiError*)error {
     
+    [[LoginTrace sharedTrace] endSpan:@"exchange"];
+    [[LoginTrace sharedTrace] finishWithError:error];
+    
     NSLog(@"Logged in user: %@ toNetwork: %d withError: %@", user, network, error);
     
     [user describe];
     
+    if(error == nil) {
+        [[SessionStore sharedStore] saveSessionForUser:user];
+        [[TokenRefresher sharedRefresher] start];
+        
+        [[LoginPrefetcher sharedPrefetcher] prefetchForUser:user withCompletion:^(NSDictionary *results, NSDictionary *errors) {
+            NSLog(@"Prefetched: %@ withErrors: %@", [results allKeys], errors);
+        }];
+        
+#ifdef DEBUG
+        // launch with -RunBenchmarks YES to log before/after timings
+        if([[NSUserDefaults standardUserDefaults] boolForKey:@"RunBenchmarks"]) {
+            [Benchmarks runWithUser:user];
+        }
+#endif
+    }
+    
 }
 
 
 - (IBAction)logIn:(id)sender {
     
+    LoginTrace *trace = [LoginTrace sharedTrace];
+    [trace begin];
+    
+    // open the Kii connection while the user is away at Facebook
+    [trace beginSpan:@"prewarm"];
+    [[LoginPrefetcher sharedPrefetcher] prewarmConnections];
+    [trace endSpan:@"prewarm"];
+    
+    [trace beginSpan:@"setup"];
     [KiiSocialConnect setupNetwork:kiiSCNFacebook
                            withKey:@"262612763838475"
                          andSecret:@"8beb4a3bf93138965ecab3f818333a9a"
                         andOptions:nil];
+    [trace endSpan:@"setup"];
     
+    // ends when handleOpenURL: brings the user back
+    [trace beginSpan:@"facebook"];
     [KiiSocialConnect logIn:kiiSCNFacebook
                usingOptions:nil
                withDelegate:self
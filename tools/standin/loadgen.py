@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+#  loadgen.py
+#  FacebookIntegration-iOS
+#
+#  Created by Kii on 10/18/26.
+#  Copyright (c) 2026 Kii. All rights reserved.
+#
+
+"""Simulates many concurrent social logins against standin_server.py.
+
+Each simulated login follows the app's path:
+
+  facebook   the OAuth exchange that leaves the app with a Facebook token
+  exchange   POST /api/apps/<app>/integration/facebook for a Kii token
+  user       GET /api/apps/<app>/users/me, as the SDK does after login
+
+--concurrency logins run at once, each on its own connection, until
+--logins have finished. Latency percentiles are reported per phase and
+for the whole login. Only the Python standard library is used.
+"""
+
+import argparse
+import http.client
+import json
+import math
+import sys
+import threading
+import time
+import urllib.parse
+
+PHASES = ("facebook", "exchange", "user", "total")
+
+
+class LoginError(Exception):
+    pass
+
+
+def request(connection, method, path, body=None, headers=None):
+    headers = dict(headers or {})
+    data = None
+    if body is not None:
+        data = json.dumps(body).encode("utf-8")
+        headers["Content-Type"] = "application/json"
+    connection.request(method, path, body=data, headers=headers)
+    response = connection.getresponse()
+    payload = response.read()
+    if response.status != 200:
+        raise LoginError("%s %s: HTTP %d" % (method, path.split("?")[0], response.status))
+    return json.loads(payload)
+
+
+def login(connection, app_id, facebook_id):
+    """Run one login and return the seconds spent in each phase."""
+    times = {}
+    started = time.perf_counter()
+
+    mark = started
+    query = urllib.parse.urlencode({"code": facebook_id})
+    facebook = request(connection, "GET", "/oauth/access_token?" + query)
+    now = time.perf_counter()
+    times["facebook"], mark = now - mark, now
+
+    kii = request(connection, "POST", "/api/apps/%s/integration/facebook" % app_id,
+                  body={"accessToken": facebook["access_token"]})
+    now = time.perf_counter()
+    times["exchange"], mark = now - mark, now
+
+    request(connection, "GET", "/api/apps/%s/users/me" % app_id,
+            headers={"Authorization": "Bearer " + kii["access_token"]})
+    now = time.perf_counter()
+    times["user"] = now - mark
+    times["total"] = now - started
+
+    return times
+
+
+def percentile(sorted_values, fraction):
+    """Nearest-rank percentile of an already sorted list."""
+    if not sorted_values:
+        return float("nan")
+    rank = max(1, int(math.ceil(fraction * len(sorted_values))))
+    return sorted_values[rank - 1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--app-id", default="28cdf645")
+    parser.add_argument("--concurrency", type=int, default=1000,
+                        help="logins in flight at once")
+    parser.add_argument("--logins", type=int, default=5000,
+                        help="total logins to run")
+    parser.add_argument("--users", type=int, default=0,
+                        help="distinct Facebook users, 0 for a new user per login")
+    parser.add_argument("--timeout", type=float, default=30)
+    args = parser.parse_args()
+
+    lock = threading.Lock()
+    next_login = [0]
+    samples = {phase: [] for phase in PHASES}
+    errors = {}
+
+    def claim():
+        with lock:
+            if next_login[0] >= args.logins:
+                return None
+            index = next_login[0]
+            next_login[0] += 1
+            return index
+
+    def worker():
+        connection = None
+        while True:
+            index = claim()
+            if index is None:
+                break
+            if connection is None:
+                connection = http.client.HTTPConnection(args.host, args.port, timeout=args.timeout)
+            facebook_id = str(index % args.users if args.users else index)
+            try:
+                times = login(connection, args.app_id, facebook_id)
+            except (LoginError, OSError, http.client.HTTPException, ValueError) as error:
+                # the connection may be half-read, so start the next login on a fresh one
+                connection.close()
+                connection = None
+                key = str(error) if isinstance(error, LoginError) else type(error).__name__
+                with lock:
+                    errors[key] = errors.get(key, 0) + 1
+                continue
+            with lock:
+                for phase in PHASES:
+                    samples[phase].append(times[phase])
+        if connection is not None:
+            connection.close()
+
+    # each thread holds a connection, so keep the stacks small
+    threading.stack_size(256 * 1024)
+    threads = [threading.Thread(target=worker, daemon=True)
+               for _ in range(min(args.concurrency, args.logins))]
+
+    started = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - started
+
+    succeeded = len(samples["total"])
+    failed = sum(errors.values())
+    print("%d logins, %d concurrent, %.2fs: %d succeeded, %d failed, %.1f logins/s"
+          % (args.logins, len(threads), elapsed, succeeded, failed, succeeded / elapsed))
+
+    print("%-10s %9s %9s %9s %9s %9s" % ("phase", "p50", "p90", "p99", "p99.9", "max"))
+    for phase in PHASES:
+        values = sorted(samples[phase])
+        row = [percentile(values, f) * 1000 for f in (0.5, 0.9, 0.99, 0.999)]
+        row.append((values[-1] if values else float("nan")) * 1000)
+        print("%-10s %7.1fms %7.1fms %7.1fms %7.1fms %7.1fms" % tuple([phase] + row))
+
+    for key, count in sorted(errors.items(), key=lambda item: -item[1]):
+        print("error %6d  %s" % (count, key))
+
+    return 1 if succeeded == 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
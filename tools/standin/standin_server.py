@@ -0,0 +1,492 @@
+#!/usr/bin/env python3
+#
+#  standin_server.py
+#  FacebookIntegration-iOS
+#
+#  Created by Kii on 10/18/26.
+#  Copyright (c) 2026 Kii. All rights reserved.
+#
+
+"""A local stand-in for the Facebook OAuth provider and the Kii user API.
+
+Serves just enough of both for the social login path to be load-tested
+without touching real services:
+
+  Facebook OAuth
+    GET  /dialog/oauth               redirects to fb<client_id>://authorize
+                                     with an access token in the fragment
+    GET  /oauth/access_token         exchanges a code, which is taken as the
+                                     Facebook user ID, for a token
+    GET  /me                         the profile behind a token
+
+  Kii (under /api, the URL given to Kii beginWithID:andKey:andCustomURL:)
+    POST /api/apps/<app>/integration/facebook
+                                     logs in or creates the user for a
+                                     Facebook token, returns a Kii token
+    POST /api/oauth2/token           logs in with username and password
+    GET  /api/apps/<app>/users/me    the user behind a Kii token
+    GET  /api/apps/<app>/users/<id>  a user by ID
+    HEAD /api                        answers the app's connection prewarm
+
+  Kii data, in memory, for the prefetch and the benchmarks. <bucket> is
+  any bucket path: buckets/<name>, users/<id>/buckets/<name> or
+  groups/<id>/buckets/<name>
+    POST   .../<bucket>/query        every object in the bucket; the clause
+                                     is ignored and there is one page only
+    POST   .../<bucket>/objects      creates an object
+    GET    .../<bucket>/objects/<id> an object
+    PUT    .../<bucket>/objects/<id> replaces an object
+    DELETE .../<bucket>/objects/<id> deletes an object
+    GET    .../acl                   the ACL of a bucket or an object
+    PUT    .../acl/<action>/<subject>
+    DELETE .../acl/<action>/<subject>
+                                     grants or revokes one ACL entry
+    POST   /api/apps/<app>/groups    creates a group owned by the caller
+    GET    /api/apps/<app>/groups?is_member=<user id>
+                                     the groups a user owns or belongs to
+    GET    /api/apps/<app>/groups/<id>
+    DELETE /api/apps/<app>/groups/<id>
+
+Anything else answers 404, among them files, topics and group member
+changes, so those paths of the app are expected to fail against it.
+
+Every response is delayed by --latency-ms plus up to --jitter-ms, and
+--error-rate of the requests fail with a 503, so clients can be tested
+against a slow or failing backend. Only the Python standard library is
+used.
+"""
+
+import argparse
+import json
+import random
+import secrets
+import threading
+import time
+import urllib.parse
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class Store:
+    """Tokens and users, shared by every request thread."""
+
+    def __init__(self, token_lifetime):
+        self.lock = threading.Lock()
+        self.token_lifetime = token_lifetime
+        self.facebook_tokens = {}   # token -> (facebook id, expiry)
+        self.users = {}             # kii id -> user dict
+        self.facebook_users = {}    # facebook id -> kii id
+        self.kii_tokens = {}        # token -> kii id
+        self.objects = {}           # bucket path -> {object id -> object dict}
+        self.acls = {}              # bucket or object path -> {action -> [subject]}
+        self.groups = {}            # group id -> group dict
+
+    def issue_facebook_token(self, facebook_id):
+        token = "fb-" + secrets.token_hex(16)
+        with self.lock:
+            self.facebook_tokens[token] = (facebook_id, time.time() + self.token_lifetime)
+        return token
+
+    def facebook_id_for(self, token):
+        with self.lock:
+            entry = self.facebook_tokens.get(token)
+        if entry is None or entry[1] < time.time():
+            return None
+        return entry[0]
+
+    def login_facebook(self, facebook_id):
+        with self.lock:
+            created = facebook_id not in self.facebook_users
+            if created:
+                user_id = secrets.token_hex(12)
+                self.users[user_id] = {
+                    "userID": user_id,
+                    "loginName": "fb_" + facebook_id,
+                    "displayName": "Stand-in " + facebook_id,
+                    "emailVerified": False,
+                    "phoneNumberVerified": False,
+                }
+                self.facebook_users[facebook_id] = user_id
+            user_id = self.facebook_users[facebook_id]
+            token = secrets.token_urlsafe(32)
+            self.kii_tokens[token] = user_id
+        return user_id, token, created
+
+    def login_password(self, username):
+        with self.lock:
+            for user_id, user in self.users.items():
+                if user["loginName"] == username:
+                    token = secrets.token_urlsafe(32)
+                    self.kii_tokens[token] = user_id
+                    return user_id, token
+        return None, None
+
+    def user_for_token(self, token):
+        with self.lock:
+            user_id = self.kii_tokens.get(token)
+            return dict(self.users[user_id]) if user_id else None
+
+    def user(self, user_id):
+        with self.lock:
+            user = self.users.get(user_id)
+            return dict(user) if user else None
+
+    def query(self, bucket):
+        with self.lock:
+            return [dict(item) for item in self.objects.get(bucket, {}).values()]
+
+    def save_object(self, bucket, object_id, body, owner):
+        now = int(time.time() * 1000)
+        with self.lock:
+            objects = self.objects.setdefault(bucket, {})
+            created = object_id is None or object_id not in objects
+            if object_id is None:
+                object_id = secrets.token_hex(12)
+            item = dict(body)
+            item.update({"_id": object_id,
+                         "_owner": owner,
+                         "_created": objects.get(object_id, {}).get("_created", now),
+                         "_modified": now,
+                         "_version": str(int(objects.get(object_id, {}).get("_version", "0")) + 1)})
+            objects[object_id] = item
+            return dict(item), created
+
+    def get_object(self, bucket, object_id):
+        with self.lock:
+            item = self.objects.get(bucket, {}).get(object_id)
+            return dict(item) if item else None
+
+    def delete_object(self, bucket, object_id):
+        with self.lock:
+            self.acls.pop(bucket + "/objects/" + object_id, None)
+            return self.objects.get(bucket, {}).pop(object_id, None) is not None
+
+    def acl(self, path):
+        with self.lock:
+            return {action: list(subjects) for action, subjects in self.acls.get(path, {}).items()}
+
+    def set_acl_entry(self, path, action, subject, grant):
+        with self.lock:
+            subjects = self.acls.setdefault(path, {}).setdefault(action, [])
+            if grant and subject not in subjects:
+                subjects.append(subject)
+            elif not grant and subject in subjects:
+                subjects.remove(subject)
+
+    def create_group(self, name, owner, members):
+        group_id = secrets.token_hex(12)
+        with self.lock:
+            self.groups[group_id] = {"groupID": group_id,
+                                     "name": name,
+                                     "owner": owner,
+                                     "members": list(members)}
+        return group_id
+
+    def group(self, group_id):
+        with self.lock:
+            group = self.groups.get(group_id)
+            return dict(group) if group else None
+
+    def groups_of(self, user_id):
+        with self.lock:
+            return [{"groupID": group["groupID"], "name": group["name"], "owner": group["owner"]}
+                    for group in self.groups.values()
+                    if group["owner"] == user_id or user_id in group["members"]]
+
+    def delete_group(self, group_id):
+        with self.lock:
+            return self.groups.pop(group_id, None) is not None
+
+
+class Handler(BaseHTTPRequestHandler):
+
+    protocol_version = "HTTP/1.1"
+    server_version = "KiiStandIn/1.0"
+
+    # small responses must not wait on delayed ACKs
+    disable_nagle_algorithm = True
+
+    # set by main()
+    store = None
+    latency = 0.0
+    jitter = 0.0
+    error_rate = 0.0
+    quiet = False
+
+    def log_message(self, format, *args):
+        if not self.quiet:
+            BaseHTTPRequestHandler.log_message(self, format, *args)
+
+    # -- responses
+
+    def send_json(self, status, body, headers=None):
+        data = json.dumps(body).encode("utf-8")
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+        self.end_headers()
+        if self.command != "HEAD":
+            self.wfile.write(data)
+
+    def send_error_json(self, status, code, message):
+        self.send_json(status, {"errorCode": code, "message": message})
+
+    def send_no_content(self):
+        self.send_response(204)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def read_json(self):
+        if not self.body:
+            return {}
+        try:
+            return json.loads(self.body)
+        except ValueError:
+            return None
+
+    def bearer_token(self):
+        header = self.headers.get("Authorization", "")
+        if header.lower().startswith("bearer "):
+            return header[7:].strip()
+        return None
+
+    # -- dispatch
+
+    def delay(self):
+        """Sleep like a real backend, and return True if this request fails."""
+        time.sleep(self.latency + random.random() * self.jitter)
+        return random.random() < self.error_rate
+
+    def route(self):
+        # read the whole body first, so a failed request leaves the
+        # keep-alive connection ready for the next one
+        length = int(self.headers.get("Content-Length") or 0)
+        self.body = self.rfile.read(length) if length else b""
+
+        if self.delay():
+            self.send_error_json(503, "SERVICE_UNAVAILABLE", "Injected failure")
+            return
+
+        url = urllib.parse.urlsplit(self.path)
+        query = dict(urllib.parse.parse_qsl(url.query))
+        parts = [part for part in url.path.split("/") if part]
+        method = self.command
+
+        if method == "GET" and parts == ["dialog", "oauth"]:
+            return self.facebook_dialog(query)
+        if method == "GET" and parts == ["oauth", "access_token"]:
+            return self.facebook_exchange(query)
+        if method == "GET" and parts == ["me"]:
+            return self.facebook_me(query)
+
+        if parts[:1] == ["api"]:
+            if method == "HEAD" and len(parts) == 1:
+                return self.send_json(200, {})
+            if method == "POST" and parts[1:] == ["oauth2", "token"]:
+                return self.kii_password_login()
+            if len(parts) >= 4 and parts[1] == "apps":
+                rest = parts[3:]
+                if method == "POST" and rest == ["integration", "facebook"]:
+                    return self.kii_facebook_login()
+                if method == "GET" and len(rest) == 2 and rest[0] == "users":
+                    return self.kii_user(rest[1])
+                if "buckets" in rest or rest[:1] == ["groups"]:
+                    return self.kii_data(method, rest, query)
+
+        self.send_error_json(404, "NOT_FOUND", "No stand-in for %s %s" % (method, url.path))
+
+    def do_GET(self):
+        self.route()
+
+    def do_POST(self):
+        self.route()
+
+    def do_HEAD(self):
+        self.route()
+
+    def do_PUT(self):
+        self.route()
+
+    def do_DELETE(self):
+        self.route()
+
+    # -- Facebook
+
+    def facebook_dialog(self, query):
+        client_id = query.get("client_id", "0")
+        facebook_id = query.get("user") or str(random.randrange(10 ** 9))
+        token = self.store.issue_facebook_token(facebook_id)
+        location = "fb%s://authorize#access_token=%s&expires_in=%d" % (
+            client_id, token, self.store.token_lifetime)
+        self.send_response(302)
+        self.send_header("Location", location)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def facebook_exchange(self, query):
+        # the stand-in has no real dialog, so the code is the Facebook user ID
+        facebook_id = query.get("code")
+        if not facebook_id:
+            return self.send_error_json(400, "OAuthException", "Missing code")
+        token = self.store.issue_facebook_token(facebook_id)
+        self.send_json(200, {"access_token": token,
+                             "token_type": "bearer",
+                             "expires_in": self.store.token_lifetime})
+
+    def facebook_me(self, query):
+        facebook_id = self.store.facebook_id_for(query.get("access_token", ""))
+        if facebook_id is None:
+            return self.send_error_json(400, "OAuthException", "Invalid OAuth access token")
+        self.send_json(200, {"id": facebook_id, "name": "Stand-in " + facebook_id})
+
+    # -- Kii
+
+    def kii_facebook_login(self):
+        body = self.read_json()
+        if body is None:
+            return self.send_error_json(400, "INVALID_INPUT_DATA", "Body is not JSON")
+        facebook_id = self.store.facebook_id_for(body.get("accessToken", ""))
+        if facebook_id is None:
+            return self.send_error_json(401, "INVALID_GRANT", "Facebook token rejected")
+        user_id, token, created = self.store.login_facebook(facebook_id)
+        self.send_json(200, {"id": user_id,
+                             "access_token": token,
+                             "new_user_created": created})
+
+    def kii_password_login(self):
+        body = self.read_json()
+        if body is None:
+            return self.send_error_json(400, "INVALID_INPUT_DATA", "Body is not JSON")
+        user_id, token = self.store.login_password(body.get("username", ""))
+        if user_id is None:
+            return self.send_error_json(400, "invalid_grant", "Unknown user")
+        self.send_json(200, {"id": user_id,
+                             "access_token": token,
+                             "expires_in": 2147483647,
+                             "token_type": "bearer"})
+
+    def kii_user(self, user_id):
+        token = self.bearer_token()
+        caller = self.store.user_for_token(token) if token else None
+        if caller is None:
+            return self.send_error_json(401, "WRONG_TOKEN", "The provided token is not valid")
+        user = caller if user_id == "me" else self.store.user(user_id)
+        if user is None:
+            return self.send_error_json(404, "USER_NOT_FOUND", "User %s not found" % user_id)
+        self.send_json(200, user)
+
+    def kii_data(self, method, rest, query):
+        token = self.bearer_token()
+        caller = self.store.user_for_token(token) if token else None
+        if caller is None:
+            return self.send_error_json(401, "WRONG_TOKEN", "The provided token is not valid")
+
+        if "buckets" not in rest:
+            return self.kii_group(method, rest[1:], query, caller)
+
+        # everything up to the bucket name is the bucket's path
+        split = rest.index("buckets") + 2
+        bucket, tail = "/".join(rest[:split]), rest[split:]
+
+        if "acl" in tail:
+            at = tail.index("acl")
+            path = "/".join([bucket] + tail[:at])
+            entry = tail[at + 1:]
+            if method == "GET" and not entry:
+                return self.send_json(200, self.store.acl(path))
+            if method in ("PUT", "DELETE") and len(entry) == 2:
+                self.store.set_acl_entry(path, entry[0], entry[1], method == "PUT")
+                return self.send_no_content()
+
+        elif method == "POST" and tail == ["query"]:
+            return self.send_json(200, {"queryDescription": "WHERE ( 1 = 1 )",
+                                        "results": self.store.query(bucket)})
+
+        elif tail[:1] == ["objects"]:
+            body = self.read_json()
+            if body is None:
+                return self.send_error_json(400, "INVALID_INPUT_DATA", "Body is not JSON")
+            if method == "POST" and len(tail) == 1:
+                item, _ = self.store.save_object(bucket, None, body, caller["userID"])
+                return self.send_json(201, {"objectID": item["_id"],
+                                            "createdAt": item["_created"],
+                                            "dataType": "application/vnd." + rest[split - 1] + "+json"})
+            if len(tail) == 2:
+                if method == "GET":
+                    item = self.store.get_object(bucket, tail[1])
+                    if item is None:
+                        return self.send_error_json(404, "OBJECT_NOT_FOUND", "Object %s not found" % tail[1])
+                    return self.send_json(200, item, {"ETag": '"%s"' % item["_version"]})
+                if method == "PUT":
+                    item, created = self.store.save_object(bucket, tail[1], body, caller["userID"])
+                    return self.send_json(201 if created else 200,
+                                          {"createdAt": item["_created"], "modifiedAt": item["_modified"]},
+                                          {"ETag": '"%s"' % item["_version"]})
+                if method == "DELETE":
+                    if not self.store.delete_object(bucket, tail[1]):
+                        return self.send_error_json(404, "OBJECT_NOT_FOUND", "Object %s not found" % tail[1])
+                    return self.send_no_content()
+
+        self.send_error_json(404, "NOT_FOUND", "No stand-in for %s %s" % (method, self.path))
+
+    def kii_group(self, method, rest, query, caller):
+        if method == "POST" and not rest:
+            body = self.read_json()
+            if body is None or not body.get("name"):
+                return self.send_error_json(400, "INVALID_INPUT_DATA", "A group needs a name")
+            group_id = self.store.create_group(body["name"], caller["userID"], body.get("members", []))
+            return self.send_json(201, {"groupID": group_id, "notFoundUsers": []})
+        if method == "GET" and not rest and "is_member" in query:
+            return self.send_json(200, {"groups": self.store.groups_of(query["is_member"])})
+        if len(rest) == 1:
+            if method == "GET":
+                group = self.store.group(rest[0])
+                if group is None:
+                    return self.send_error_json(404, "GROUP_NOT_FOUND", "Group %s not found" % rest[0])
+                group.pop("members")
+                return self.send_json(200, group)
+            if method == "DELETE":
+                if not self.store.delete_group(rest[0]):
+                    return self.send_error_json(404, "GROUP_NOT_FOUND", "Group %s not found" % rest[0])
+                return self.send_no_content()
+        self.send_error_json(404, "NOT_FOUND", "No stand-in for %s %s" % (method, self.path))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--latency-ms", type=float, default=20,
+                        help="fixed delay added to every response")
+    parser.add_argument("--jitter-ms", type=float, default=30,
+                        help="random delay, up to this much, added on top")
+    parser.add_argument("--error-rate", type=float, default=0.0,
+                        help="fraction of requests that fail with a 503")
+    parser.add_argument("--token-lifetime", type=int, default=60 * 60 * 24 * 60,
+                        help="Facebook token lifetime in seconds")
+    parser.add_argument("--quiet", action="store_true", help="do not log each request")
+    args = parser.parse_args()
+
+    Handler.store = Store(args.token_lifetime)
+    Handler.latency = args.latency_ms / 1000.0
+    Handler.jitter = args.jitter_ms / 1000.0
+    Handler.error_rate = args.error_rate
+    Handler.quiet = args.quiet
+
+    # thousands of clients connect at once, so the listen backlog must be deep
+    ThreadingHTTPServer.request_queue_size = 4096
+    ThreadingHTTPServer.daemon_threads = True
+    server = ThreadingHTTPServer((args.host, args.port), Handler)
+
+    print("Stand-in listening on http://%s:%d (Kii API at /api)" % (args.host, args.port), flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+
+
+if __name__ == "__main__":
+    main()